@@ -786,7 +786,8 @@ CREATE TABLE `tw_accounts_quests` (
   `ID` int(11) NOT NULL,
   `QuestID` int(11) DEFAULT NULL,
   `UserID` int(11) NOT NULL,
-  `Type` int(11) NOT NULL DEFAULT 0
+  `Type` int(11) NOT NULL DEFAULT 0,
+  `StepsData` varchar(1024) NOT NULL DEFAULT ''
 ) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
 
 --
@@ -1602,6 +1603,17 @@ INSERT INTO `tw_houses_decorations` (`ID`, `PosX`, `PosY`, `HouseID`, `DecoID`,
 
 -- --------------------------------------------------------
 
+--
+-- Структура таблицы `tw_id_sequences`
+--
+
+CREATE TABLE `tw_id_sequences` (
+  `Name` varchar(64) NOT NULL,
+  `NextID` int(11) NOT NULL DEFAULT 1
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+-- --------------------------------------------------------
+
 --
 -- Структура таблицы `tw_items_list`
 --
@@ -2286,6 +2298,12 @@ ALTER TABLE `tw_houses_decorations`
   ADD KEY `HouseID` (`HouseID`),
   ADD KEY `DecoID` (`DecoID`);
 
+--
+-- Индексы таблицы `tw_id_sequences`
+--
+ALTER TABLE `tw_id_sequences`
+  ADD PRIMARY KEY (`Name`);
+
 --
 -- Индексы таблицы `tw_items_list`
 --
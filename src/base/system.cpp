@@ -7,6 +7,8 @@
 #include <ctype.h>
 #include <time.h>
 
+#include <atomic>
+
 #include "system.h"
 
 #include <sys/stat.h>
@@ -67,7 +69,14 @@ IOHANDLE io_stderr() { return (IOHANDLE)stderr; }
 static DBG_LOGGER loggers[16];
 static int num_loggers = 0;
 
-static NETSTATS network_stats = { 0 };
+// updated from the network receive thread as well
+static struct
+{
+	std::atomic<int> sent_packets{0};
+	std::atomic<int> sent_bytes{0};
+	std::atomic<int> recv_packets{0};
+	std::atomic<int> recv_bytes{0};
+} network_stats;
 
 static NETSOCKET invalid_socket = { NETTYPE_INVALID, -1, -1 };
 
@@ -1366,8 +1375,8 @@ int net_udp_send(NETSOCKET sock, const NETADDR* addr, const void* data, int size
 			dbg_msg("net", "\taddr = %s", addrstr);
 
 		}*/
-	network_stats.sent_bytes += size;
-	network_stats.sent_packets++;
+	network_stats.sent_bytes.fetch_add(size, std::memory_order_relaxed);
+	network_stats.sent_packets.fetch_add(1, std::memory_order_relaxed);
 	return d;
 }
 
@@ -1422,8 +1431,8 @@ int net_udp_recv(NETSOCKET sock, NETADDR* addr, void* buffer, int maxsize, MMSGS
 		bytes = m->msgs[m->pos].msg_len;
 		*data = (unsigned char*)m->bufs[m->pos];
 		m->pos++;
-		network_stats.recv_bytes += bytes;
-		network_stats.recv_packets++;
+		network_stats.recv_bytes.fetch_add(bytes, std::memory_order_relaxed);
+		network_stats.recv_packets.fetch_add(1, std::memory_order_relaxed);
 		return bytes;
 	}
 #else
@@ -1456,8 +1465,8 @@ int net_udp_recv(NETSOCKET sock, NETADDR* addr, void* buffer, int maxsize, MMSGS
 	if (bytes > 0)
 	{
 		sockaddr_to_netaddr((struct sockaddr*)&sockaddrbuf, addr);
-		network_stats.recv_bytes += bytes;
-		network_stats.recv_packets++;
+		network_stats.recv_bytes.fetch_add(bytes, std::memory_order_relaxed);
+		network_stats.recv_packets.fetch_add(1, std::memory_order_relaxed);
 		return bytes;
 	}
 	else if (bytes == 0)
@@ -2984,7 +2993,10 @@ int mem_comp(const void *a, const void *b, int size)
 
 void net_stats(NETSTATS *stats_inout)
 {
-	*stats_inout = network_stats;
+	stats_inout->sent_packets = network_stats.sent_packets.load(std::memory_order_relaxed);
+	stats_inout->sent_bytes = network_stats.sent_bytes.load(std::memory_order_relaxed);
+	stats_inout->recv_packets = network_stats.recv_packets.load(std::memory_order_relaxed);
+	stats_inout->recv_bytes = network_stats.recv_bytes.load(std::memory_order_relaxed);
 }
 
 int str_isspace(char c) { return c == ' ' || c == '\n' || c == '\t'; }
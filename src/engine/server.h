@@ -6,6 +6,8 @@
 #include "kernel.h"
 #include "message.h"
 
+#include <teeother/components/localization.h>
+
 #define DC_SERVER_INFO 13872503
 #define DC_PLAYER_INFO 1346299
 #define DC_JOIN_LEAVE 14494801
@@ -62,6 +64,8 @@ public:
 
 	virtual int GetClientVersion(int ClientID) const = 0;
 	virtual int SendMsg(CMsgPacker *pMsg, int Flags, int ClientID, int64 Mask = -1, int WorldID = -1) = 0;
+	// packs the message once and sends it to each client of the mask, the same clients SendMsg(pMsg, Flags, ClientID) reaches
+	virtual int SendMsgMasked(CMsgPacker *pMsg, int Flags, int64 Mask) = 0;
 
 	bool Translate(int& Target, int Client)
 	{
@@ -193,6 +197,7 @@ public:
 
 	virtual void SetClientLanguage(int ClientID, const char* pLanguage) = 0;
 	virtual const char* GetClientLanguage(int ClientID) const = 0;
+	virtual CLocalization::CLanguage* GetClientLanguageInfo(int ClientID) const = 0;
 
 	// discord
 	virtual void SendDiscordMessage(const char *pChannel, int Color, const char* pTitle, const char* pText) = 0;
@@ -224,6 +229,8 @@ public:
 
 	virtual int* GetIdMap(int ClientID) = 0;
 
+	virtual class CTickProfiler* Profiler() = 0;
+
 	virtual void ExpireServerInfo() = 0;
 };
 
@@ -70,6 +70,7 @@ CServer::CServer() : m_Register()
 	m_pServerBan = new CServerBan;
 	m_pMultiWorlds = new CMultiWorlds;
 
+	InitProfilerSections();
 	Init();
 }
 
@@ -219,6 +220,7 @@ void CServer::SetClientLanguage(int ClientID, const char* pLanguage)
 		return;
 
 	str_copy(m_aClients[ClientID].m_aLanguage, pLanguage, sizeof(m_aClients[ClientID].m_aLanguage));
+	m_aClients[ClientID].m_pLanguage = Localization()->GetLanguage(m_aClients[ClientID].m_aLanguage);
 }
 
 bool CServer::IsClientChangesWorld(int ClientID)
@@ -249,6 +251,16 @@ const char* CServer::GetClientLanguage(int ClientID) const
 	return m_aClients[ClientID].m_aLanguage;
 }
 
+CLocalization::CLanguage* CServer::GetClientLanguageInfo(int ClientID) const
+{
+	if(ClientID < 0 || ClientID >= MAX_CLIENTS || m_aClients[ClientID].m_State < CClient::STATE_READY)
+		return Localization()->GetLanguage("en");
+
+	// read from the vote jobs too, so the pointer is only ever written on the game thread
+	CLocalization::CLanguage* pLanguage = m_aClients[ClientID].m_pLanguage;
+	return pLanguage ? pLanguage : Localization()->GetLanguage("en");
+}
+
 void CServer::ChangeWorld(int ClientID, int NewWorldID)
 {
 	if(ClientID < 0 || ClientID >= MAX_PLAYERS || NewWorldID == m_aClients[ClientID].m_WorldID || !MultiWorlds()->IsValid(NewWorldID) || m_aClients[ClientID].m_State < CClient::STATE_READY)
@@ -346,9 +358,13 @@ int CServer::Init()
 	m_WorldHour = 0;
 	m_IsNewMinute = false;
 	m_CurrentGameTick = 0;
+	for(auto& Client : m_aClients)
+	{
+		str_copy(Client.m_aLanguage, "en", sizeof(Client.m_aLanguage));
+		Client.m_pLanguage = nullptr;
+	}
 	for(int i = 0; i < MAX_PLAYERS; i++)
 	{
-		str_copy(m_aClients[i].m_aLanguage, "en", sizeof(m_aClients[i].m_aLanguage));
 		m_aClients[i].m_State = CClient::STATE_EMPTY;
 		m_aClients[i].m_aName[0] = 0;
 		m_aClients[i].m_aClan[0] = 0;
@@ -609,6 +625,37 @@ int CServer::SendMsg(CMsgPacker *pMsg, int Flags, int ClientID, int64 Mask, int
 	return 0;
 }
 
+int CServer::SendMsgMasked(CMsgPacker *pMsg, int Flags, int64 Mask)
+{
+	if(!pMsg)
+		return -1;
+	if(Flags&MSGFLAG_NOSEND)
+		return 0;
+
+	CPacker Pack;
+	if(RepackMsg(pMsg, Pack))
+		return -1;
+
+	CNetChunk Packet;
+	mem_zero(&Packet, sizeof(CNetChunk));
+	Packet.m_pData = Pack.Data();
+	Packet.m_DataSize = Pack.Size();
+	if(Flags&MSGFLAG_VITAL)
+		Packet.m_Flags |= NETSENDFLAG_VITAL;
+	if(Flags&MSGFLAG_FLUSH)
+		Packet.m_Flags |= NETSENDFLAG_FLUSH;
+
+	for(int i = 0; i < MAX_PLAYERS; i++)
+	{
+		if((Mask & (int64)1 << i) == 0 || m_aClients[i].m_State == CClient::STATE_EMPTY || m_aClients[i].m_Quitting)
+			continue;
+
+		Packet.m_ClientID = i;
+		m_NetServer.Send(&Packet);
+	}
+	return 0;
+}
+
 void CServer::DoSnapshot(int WorldID)
 {
 	GameServer(WorldID)->OnPreSnap();
@@ -759,6 +806,7 @@ int CServer::NewClientCallback(int ClientID, void *pUser, bool Sixup)
 	CServer *pThis = (CServer *)pUser;
 	pThis->GameServer(MAIN_WORLD_ID)->ClearClientData(ClientID);
 	str_copy(pThis->m_aClients[ClientID].m_aLanguage, "en", sizeof(pThis->m_aClients[ClientID].m_aLanguage));
+	pThis->m_aClients[ClientID].m_pLanguage = pThis->Localization()->GetLanguage("en");
 	pThis->m_aClients[ClientID].m_State = CClient::STATE_AUTH;
 	pThis->m_aClients[ClientID].m_aName[0] = 0;
 	pThis->m_aClients[ClientID].m_aClan[0] = 0;
@@ -1763,6 +1811,8 @@ int CServer::Run()
 		return -1;
 	}
 	m_NetServer.SetCallbacks(NewClientCallback, NewClientNoAuthCallback, ClientRejoinCallback, DelClientCallback, this);
+	if(g_Config.m_SvNetThread && !m_NetServer.StartRecvThread())
+		dbg_msg("server", "couldn't start network receive thread, falling back to the main thread");
 	m_Econ.Init(Console(), m_pServerBan);
 
 	str_format(aBuf, sizeof(aBuf), "server name is '%s'", g_Config.m_SvName);
@@ -1775,6 +1825,7 @@ int CServer::Run()
 	}
 	for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
 		MultiWorlds()->GetWorld(i)->m_pGameServer->OnInit(i);
+	InitProfilerSections();
 
 	str_format(aBuf, sizeof(aBuf), "version %s", GameServer()->NetVersion());
 	Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
@@ -1806,8 +1857,12 @@ int CServer::Run()
 			bool ShouldSnap = false;
 			bool ExistsPlayers = false;
 
+			m_Profiler.SetEnabled(g_Config.m_SvProfiler);
 			while(t > TickStartTime(m_CurrentGameTick+1))
 			{
+				// everything since the previous tick (snapshots, network) belongs to that tick
+				m_Profiler.OnTickEnd();
+				CProfileScope TickScope(&m_Profiler, m_ProfilerTick);
 				NewTicks = true;
 
 				m_CurrentGameTick++;
@@ -1815,22 +1870,25 @@ int CServer::Run()
 					ShouldSnap = true;
 
 				// apply new input
-				for(int c = 0; c < MAX_PLAYERS; c++)
 				{
-					if(m_aClients[c].m_State == CClient::STATE_EMPTY)
-						continue;
-
-					ExistsPlayers = true;
-					for (auto& m_aInput : m_aClients[c].m_aInputs)
+					CProfileScope InputScope(&m_Profiler, m_ProfilerInput);
+					for(int c = 0; c < MAX_PLAYERS; c++)
 					{
-						if(m_aInput.m_GameTick == Tick())
+						if(m_aClients[c].m_State == CClient::STATE_EMPTY)
+							continue;
+
+						ExistsPlayers = true;
+						for (auto& m_aInput : m_aClients[c].m_aInputs)
 						{
-							if(m_aClients[c].m_State == CClient::STATE_INGAME)
+							if(m_aInput.m_GameTick == Tick())
 							{
-								const int WorldID = m_aClients[c].m_WorldID;
-								GameServer(WorldID)->OnClientPredictedInput(c, m_aInput.m_aData);
+								if(m_aClients[c].m_State == CClient::STATE_INGAME)
+								{
+									const int WorldID = m_aClients[c].m_WorldID;
+									GameServer(WorldID)->OnClientPredictedInput(c, m_aInput.m_aData);
+								}
+								break;
 							}
-							break;
 						}
 					}
 				}
@@ -1854,9 +1912,13 @@ int CServer::Run()
 					}
 				}
 
-				MultiWorlds()->GetWorld(MAIN_WORLD_ID)->m_pGameServer->OnTickMainWorld();
+				{
+					CProfileScope MainWorldScope(&m_Profiler, m_ProfilerMainWorld);
+					MultiWorlds()->GetWorld(MAIN_WORLD_ID)->m_pGameServer->OnTickMainWorld();
+				}
 				for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
 				{
+					CProfileScope WorldScope(&m_Profiler, m_aProfilerWorldTick[i]);
 					IGameServer* pGameServer = MultiWorlds()->GetWorld(i)->m_pGameServer;
 					pGameServer->OnTick();
 				}
@@ -1916,6 +1978,7 @@ int CServer::Run()
 						IGameServer* pGameServer = MultiWorlds()->GetWorld(i)->m_pGameServer;
 						pGameServer->OnInit(i);
 					}
+					InitProfilerSections();
 
 					UpdateServerInfo(true);
 					Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", "A server was heavy reload.");
@@ -1926,10 +1989,18 @@ int CServer::Run()
 					if(g_Config.m_SvHighBandwidth || ShouldSnap)
 					{
 						for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
+						{
+							CProfileScope SnapScope(&m_Profiler, m_aProfilerWorldSnap[i]);
 							DoSnapshot(i);
+						}
 					}
 					UpdateClientRconCommands();
 				}
+
+				if(g_Config.m_SvProfilerDumpInterval && Tick() % (g_Config.m_SvProfilerDumpInterval * TickSpeed()) == 0)
+					DumpProfiler(g_Config.m_SvProfilerDumpFile);
+				if(g_Config.m_SvMySqlStatsDumpInterval && Tick() % (g_Config.m_SvMySqlStatsDumpInterval * TickSpeed()) == 0)
+					DumpSqlStats(g_Config.m_SvMySqlStatsDumpFile);
 			}
 
 			// master server stuff
@@ -1938,10 +2009,13 @@ int CServer::Run()
 			if (m_ServerInfoNeedsUpdate)
 				UpdateServerInfo();
 
-			PumpNetwork();
+			{
+				CProfileScope NetworkScope(&m_Profiler, m_ProfilerNetwork);
+				PumpNetwork();
+			}
 
 			// wait for incomming data
-			net_socket_read_wait(m_NetServer.Socket(), clamp(int((TickStartTime(m_CurrentGameTick + 1) - time_get()) * 1000 / time_freq()), 1, 1000 / SERVER_TICK_SPEED / 2));
+			m_NetServer.WaitForData(clamp(int((TickStartTime(m_CurrentGameTick + 1) - time_get()) * 1000 / time_freq()), 1, 1000 / SERVER_TICK_SPEED / 2));
 		}
 	}
 
@@ -2014,6 +2088,108 @@ void CServer::ConLogout(IConsole::IResult *pResult, void *pUser)
 	}
 }
 
+void CServer::ConProfiler(IConsole::IResult *pResult, void *pUser)
+{
+	CServer *pThis = (CServer *)pUser;
+	const char *pFilter = pResult->NumArguments() ? pResult->GetString(0) : "";
+	if(!pThis->m_Profiler.IsEnabled())
+	{
+		pThis->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "profiler", "profiler is disabled, enable it with sv_profiler 1");
+		return;
+	}
+
+	char aBuf[256];
+	str_format(aBuf, sizeof(aBuf), "%-32s %7s %7s %7s %7s %7s (ms over the last %d ticks)", "section", "avg", "p50", "p95", "p99", "max", (int)CTickProfiler::WINDOW_TICKS);
+	pThis->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "profiler", aBuf);
+	for(int i = 0; i < pThis->m_Profiler.NumSections(); i++)
+	{
+		const char *pName = pThis->m_Profiler.SectionName(i);
+		if(pFilter[0] && !str_find_nocase(pName, pFilter))
+			continue;
+
+		CTickProfiler::CStats Stats;
+		pThis->m_Profiler.GetStats(i, &Stats);
+		if(!Stats.m_NumSamples)
+			continue;
+
+		str_format(aBuf, sizeof(aBuf), "%-32s %7.3f %7.3f %7.3f %7.3f %7.3f", pName, Stats.m_AvgUs / 1000.0f,
+			Stats.m_P50Us / 1000.0f, Stats.m_P95Us / 1000.0f, Stats.m_P99Us / 1000.0f, Stats.m_MaxUs / 1000.0f);
+		pThis->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "profiler", aBuf);
+	}
+}
+
+void CServer::ConProfilerDump(IConsole::IResult *pResult, void *pUser)
+{
+	CServer *pThis = (CServer *)pUser;
+	pThis->DumpProfiler(pResult->NumArguments() ? pResult->GetString(0) : g_Config.m_SvProfilerDumpFile);
+}
+
+void CServer::ConSqlStats(IConsole::IResult *pResult, void *pUser)
+{
+	CServer *pThis = (CServer *)pUser;
+	g_SqlStats.Print(pThis->Console(), pResult->NumArguments() ? pResult->GetString(0) : "");
+}
+
+void CServer::ConSqlStatsDump(IConsole::IResult *pResult, void *pUser)
+{
+	CServer *pThis = (CServer *)pUser;
+	pThis->DumpSqlStats(pResult->NumArguments() ? pResult->GetString(0) : g_Config.m_SvMySqlStatsDumpFile);
+}
+
+void CServer::ConSqlStatsReset(IConsole::IResult *pResult, void *pUser)
+{
+	g_SqlStats.Reset();
+}
+
+void CServer::InitProfilerSections()
+{
+	m_ProfilerTick = m_Profiler.RegisterSection("tick");
+	m_ProfilerInput = m_Profiler.RegisterSection("tick.input");
+	m_ProfilerMainWorld = m_Profiler.RegisterSection("tick.main_world");
+	m_ProfilerNetwork = m_Profiler.RegisterSection("network");
+
+	char aBuf[64];
+	for(int i = 0; i < ENGINE_MAX_WORLDS; i++)
+	{
+		if(i >= MultiWorlds()->GetSizeInitilized())
+		{
+			m_aProfilerWorldTick[i] = -1;
+			m_aProfilerWorldSnap[i] = -1;
+			continue;
+		}
+
+		str_format(aBuf, sizeof(aBuf), "world%d.tick", i);
+		m_aProfilerWorldTick[i] = m_Profiler.RegisterSection(aBuf);
+		str_format(aBuf, sizeof(aBuf), "world%d.snap", i);
+		m_aProfilerWorldSnap[i] = m_Profiler.RegisterSection(aBuf);
+	}
+}
+
+void CServer::DumpSqlStats(const char *pFilename)
+{
+	IOHANDLE File = Storage()->OpenFile(pFilename, IOFLAG_WRITE, IStorageEngine::TYPE_SAVE);
+	if(!g_SqlStats.WriteJson(File))
+	{
+		char aBuf[256];
+		str_format(aBuf, sizeof(aBuf), "failed to open '%s' for writing", pFilename);
+		Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "sql", aBuf);
+	}
+}
+
+void CServer::DumpProfiler(const char *pFilename)
+{
+	if(!m_Profiler.IsEnabled())
+		return;
+
+	IOHANDLE File = Storage()->OpenFile(pFilename, IOFLAG_WRITE, IStorageEngine::TYPE_SAVE);
+	if(!m_Profiler.WriteJson(File, Tick()))
+	{
+		char aBuf[256];
+		str_format(aBuf, sizeof(aBuf), "failed to open '%s' for writing", pFilename);
+		Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "profiler", aBuf);
+	}
+}
+
 void CServer::ConchainSpecialInfoupdate(IConsole::IResult* pResult, void* pUserData, IConsole::FCommandCallback pfnCallback, void* pCallbackUserData)
 {
 	pfnCallback(pResult, pCallbackUserData);
@@ -2090,6 +2266,11 @@ void CServer::RegisterCommands()
 	Console()->Register("shutdown", "", CFGFLAG_SERVER, ConShutdown, this, "Shut down");
 	Console()->Register("reload", "", CFGFLAG_SERVER, ConReload, this, "Reload maps and synchronize data with the database");
 	Console()->Register("logout", "", CFGFLAG_SERVER, ConLogout, this, "Logout of rcon");
+	Console()->Register("profiler", "?s[filter]", CFGFLAG_SERVER, ConProfiler, this, "Show tick time percentiles per section");
+	Console()->Register("profiler_dump", "?s[file]", CFGFLAG_SERVER, ConProfilerDump, this, "Write tick profiler statistics as json");
+	Console()->Register("sql_stats", "?s[filter]", CFGFLAG_SERVER, ConSqlStats, this, "Show queue depth and latency per query template");
+	Console()->Register("sql_stats_dump", "?s[file]", CFGFLAG_SERVER, ConSqlStatsDump, this, "Write SQL statistics as json");
+	Console()->Register("sql_stats_reset", "", CFGFLAG_SERVER, ConSqlStatsReset, this, "Clear the SQL statistics");
 
 	Console()->Chain("sv_name", ConchainSpecialInfoupdate, this);
 	Console()->Chain("password", ConchainSpecialInfoupdate, this);
@@ -2115,6 +2296,8 @@ void CServer::InitClientBot(int ClientID)
 	m_aClients[ClientID].m_State = CClient::STATE_INGAME;
 	m_aClients[ClientID].m_WorldID = -1;
 	m_aClients[ClientID].m_Score = 1;
+	str_copy(m_aClients[ClientID].m_aLanguage, "en", sizeof(m_aClients[ClientID].m_aLanguage));
+	m_aClients[ClientID].m_pLanguage = Localization()->GetLanguage("en");
 
 	SendConnectionReady(ClientID);
 }
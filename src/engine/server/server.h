@@ -4,6 +4,7 @@
 #define ENGINE_SERVER_SERVER_H
 #include <engine/server.h>
 
+#include <engine/shared/profiler.h>
 #include <engine/shared/uuid_manager.h>
 
 class CServer : public IServer
@@ -69,6 +70,7 @@ public:
 		char m_aNameChangeRequest[MAX_NAME_LENGTH];
 		char m_aClan[MAX_CLAN_LENGTH];
 		char m_aLanguage[MAX_LANGUAGE_LENGTH];
+		CLocalization::CLanguage* m_pLanguage; // resolved from m_aLanguage on the game thread whenever it changes
 
 		int m_Version;
 		int m_Country;
@@ -126,6 +128,18 @@ public:
 
 	CRegister m_Register;
 
+	// tick profiling
+	CTickProfiler m_Profiler;
+	int m_ProfilerTick;
+	int m_ProfilerInput;
+	int m_ProfilerMainWorld;
+	int m_ProfilerNetwork;
+	int m_aProfilerWorldTick[ENGINE_MAX_WORLDS];
+	int m_aProfilerWorldSnap[ENGINE_MAX_WORLDS];
+	void InitProfilerSections();
+	void DumpProfiler(const char *pFilename);
+	void DumpSqlStats(const char *pFilename);
+
 	CServer();
 	~CServer() override;
 
@@ -159,6 +173,7 @@ public:
 
 	void SetClientLanguage(int ClientID, const char* pLanguage) override;
 	const char* GetClientLanguage(int ClientID) const override;
+	CLocalization::CLanguage* GetClientLanguageInfo(int ClientID) const override;
 	const char* GetWorldName(int WorldID) override;
 	int GetWorldsSize() const override;
 
@@ -190,6 +205,7 @@ public:
 	
 	int GetClientVersion(int ClientID) const override;
 	int SendMsg(CMsgPacker* pMsg, int Flags, int ClientID, int64 Mask = -1, int WorldID = -1) override;
+	int SendMsgMasked(CMsgPacker* pMsg, int Flags, int64 Mask) override;
 
 	void DoSnapshot(int WorldID);
 
@@ -257,6 +273,11 @@ public:
 	static void ConShutdown(IConsole::IResult *pResult, void *pUser);
 	static void ConReload(IConsole::IResult *pResult, void *pUser);
 	static void ConLogout(IConsole::IResult *pResult, void *pUser);
+	static void ConProfiler(IConsole::IResult *pResult, void *pUser);
+	static void ConProfilerDump(IConsole::IResult *pResult, void *pUser);
+	static void ConSqlStats(IConsole::IResult *pResult, void *pUser);
+	static void ConSqlStatsDump(IConsole::IResult *pResult, void *pUser);
+	static void ConSqlStatsReset(IConsole::IResult *pResult, void *pUser);
 
 	static void ConchainSpecialInfoupdate(IConsole::IResult *pResult, void *pUserData, IConsole::FCommandCallback pfnCallback, void *pCallbackUserData);
 	static void ConchainMaxclientsperipUpdate(IConsole::IResult *pResult, void *pUserData, IConsole::FCommandCallback pfnCallback, void *pCallbackUserData);
@@ -275,6 +296,8 @@ public:
 	void SnapSetStaticsize(int ItemType, int Size) override;
 
 	int* GetIdMap(int ClientID) override;
+
+	CTickProfiler* Profiler() override { return &m_Profiler; }
 };
 
 #endif
\ No newline at end of file
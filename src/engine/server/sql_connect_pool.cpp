@@ -1,8 +1,11 @@
+#include <base/math.h>
 #include <base/system.h>
 
 #include "sql_connect_pool.h"
 
+#include <engine/console.h>
 #include <engine/shared/config.h>
+#include <engine/shared/jsonwriter.h>
 
 /*
 	I don't see the point in using SELECT operations in the thread,
@@ -153,4 +156,269 @@ void CConectionPool::DisconnectConnectionHeap()
 	{
 		DisconnectConnection(pConn);
 	}
-}
\ No newline at end of file
+}
+
+int CConectionPool::ReserveIDs(const char* pTable, int Count)
+{
+	static std::once_flag s_CreateTable;
+	const std::string Template = CSqlStats::MakeTemplate(DB::UPDATE, "tw_id_sequences");
+	std::string Query;
+	const char* pError = nullptr;
+	int FirstID = -1;
+
+	const int64 QueuedTime = g_SqlStats.OnQueued();
+	g_SqlThreadRecursiveLock.lock();
+	const int64 StartTime = g_SqlStats.OnStarted();
+	m_pDriver->threadInit();
+	Connection* pConnection = GetConnection();
+	try
+	{
+		const std::unique_ptr<Statement> pStmt(pConnection->createStatement());
+		std::call_once(s_CreateTable, [&pStmt]()
+		{
+			pStmt->execute("CREATE TABLE IF NOT EXISTS tw_id_sequences (Name VARCHAR(64) NOT NULL PRIMARY KEY, NextID INT NOT NULL DEFAULT 1) ENGINE=InnoDB;");
+		});
+
+		// the connection is ours until the lock is released, so LAST_INSERT_ID() is the value set here.
+		// the sequence never falls behind the table, rows added by other means are skipped
+		Query = "INSERT IGNORE INTO tw_id_sequences (Name, NextID) VALUES ('" + std::string(pTable) + "', 1);";
+		pStmt->execute(Query.c_str());
+		Query = "UPDATE tw_id_sequences SET NextID = LAST_INSERT_ID(GREATEST(NextID, (SELECT COALESCE(MAX(ID), 0) + 1 FROM " + std::string(pTable) + ")) + "
+			+ std::to_string(Count) + ") WHERE Name = '" + std::string(pTable) + "';";
+		pStmt->execute(Query.c_str());
+
+		const std::unique_ptr<ResultSet> pResult(pStmt->executeQuery("SELECT LAST_INSERT_ID() AS NextID;"));
+		if(pResult->next())
+			FirstID = pResult->getInt("NextID") - Count;
+		pStmt->close();
+	}
+	catch(SQLException& e)
+	{
+		pError = e.what();
+	}
+	const int64 ExecutedTime = time_get_impl();
+	ReleaseConnection(pConnection);
+	m_pDriver->threadEnd();
+	g_SqlThreadRecursiveLock.unlock();
+	g_SqlStats.OnFinished(Template, QueuedTime, StartTime, ExecutedTime, pError != nullptr);
+
+	if(pError != nullptr)
+		dbg_msg("SQL", "%s", pError);
+	return FirstID;
+}
+bool CConectionPool::ExecuteSync(const char* pQuery)
+{
+	const std::string Template = CSqlStats::MakeTemplate(DB::OTHER, pQuery);
+	const std::string Query = std::string(pQuery) + ";";
+	const char* pError = nullptr;
+
+	const int64 QueuedTime = g_SqlStats.OnQueued();
+	g_SqlThreadRecursiveLock.lock();
+	const int64 StartTime = g_SqlStats.OnStarted();
+	m_pDriver->threadInit();
+	Connection* pConnection = GetConnection();
+	try
+	{
+		const std::unique_ptr<Statement> pStmt(pConnection->createStatement());
+		pStmt->execute(Query.c_str());
+		pStmt->close();
+	}
+	catch(SQLException& e)
+	{
+		pError = e.what();
+	}
+	const int64 ExecutedTime = time_get_impl();
+	ReleaseConnection(pConnection);
+	m_pDriver->threadEnd();
+	g_SqlThreadRecursiveLock.unlock();
+	g_SqlStats.OnFinished(Template, QueuedTime, StartTime, ExecutedTime, pError != nullptr);
+
+	if(pError != nullptr)
+		dbg_msg("SQL", "%s", pError);
+	return pError == nullptr;
+}
+// #####################################################
+// SQL STATISTICS
+// #####################################################
+void CSqlStats::CHistogram::Add(int Us)
+{
+	int Bucket = 0;
+	while(Bucket < NUM_BUCKETS - 1 && (Us >> (Bucket + 1)) > 0)
+		Bucket++;
+
+	m_aBuckets[Bucket]++;
+	m_Count++;
+	m_SumUs += Us;
+	m_MaxUs = max(m_MaxUs, Us);
+}
+
+int CSqlStats::CHistogram::Percentile(int Percent) const
+{
+	if(!m_Count)
+		return 0;
+
+	// upper bound of the bucket the percentile falls into
+	const int64 Target = (m_Count * Percent + 99) / 100;
+	int64 Sum = 0;
+	for(int i = 0; i < NUM_BUCKETS; i++)
+	{
+		Sum += m_aBuckets[i];
+		if(Sum >= Target)
+			return min(m_MaxUs, (2 << i) - 1);
+	}
+	return m_MaxUs;
+}
+
+int64 CSqlStats::OnQueued()
+{
+	m_Queued++;
+	return time_get_impl();
+}
+
+int64 CSqlStats::OnStarted()
+{
+	m_Queued--;
+	m_InFlight++;
+	return time_get_impl();
+}
+
+void CSqlStats::OnFinished(const std::string& Template, int64 QueuedTime, int64 StartTime, int64 ExecutedTime, bool Error)
+{
+	m_InFlight--;
+
+	const int64 EndTime = time_get_impl();
+	if(!ExecutedTime)
+		ExecutedTime = EndTime;
+
+	const int64 Freq = time_freq() / 1000000;
+	const int WaitUs = (int)((StartTime - QueuedTime) / Freq);
+	const int ExecuteUs = (int)((ExecutedTime - StartTime) / Freq);
+	const int FetchUs = (int)((EndTime - ExecutedTime) / Freq);
+	const bool Slow = g_Config.m_SvMySqlSlowQuery && ExecuteUs + FetchUs >= g_Config.m_SvMySqlSlowQuery * 1000;
+
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		CTemplate& Stats = m_Templates[Template];
+		Stats.m_aPhases[PHASE_WAIT].Add(WaitUs);
+		Stats.m_aPhases[PHASE_EXECUTE].Add(ExecuteUs);
+		Stats.m_aPhases[PHASE_FETCH].Add(FetchUs);
+		if(Error)
+			Stats.m_Errors++;
+		if(Slow)
+			Stats.m_SlowQueries++;
+	}
+
+	// only the statement type and table, the query text carries account data like password hashes
+	if(Slow)
+		dbg_msg("SQL", "slow query (wait %.1fms, execute %.1fms, fetch %.1fms): %s", WaitUs / 1000.0f, ExecuteUs / 1000.0f, FetchUs / 1000.0f, Template.c_str());
+}
+
+void CSqlStats::Reset()
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	m_Templates.clear();
+}
+
+void CSqlStats::Print(IConsole *pConsole, const char *pFilter)
+{
+	static const char *s_apPhases[NUM_PHASES] = { "wait", "exec", "fetch" };
+
+	char aBuf[256];
+	str_format(aBuf, sizeof(aBuf), "queued: %d in flight: %d", NumQueued(), NumInFlight());
+	pConsole->Print(IConsole::OUTPUT_LEVEL_STANDARD, "sql", aBuf);
+	str_format(aBuf, sizeof(aBuf), "%-36s %-5s %8s %8s %8s %8s %8s", "query", "phase", "count", "avg", "p95", "p99", "max");
+	pConsole->Print(IConsole::OUTPUT_LEVEL_STANDARD, "sql", aBuf);
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	for(const auto& [Template, Stats] : m_Templates)
+	{
+		if(pFilter[0] && !str_find_nocase(Template.c_str(), pFilter))
+			continue;
+
+		for(int p = 0; p < NUM_PHASES; p++)
+		{
+			const CHistogram& Phase = Stats.m_aPhases[p];
+			str_format(aBuf, sizeof(aBuf), "%-36s %-5s %8lld %8.2f %8.2f %8.2f %8.2f", p == 0 ? Template.c_str() : "", s_apPhases[p], (long long)Phase.m_Count,
+				Phase.m_Count ? Phase.m_SumUs / 1000.0f / Phase.m_Count : 0.0f, Phase.Percentile(95) / 1000.0f, Phase.Percentile(99) / 1000.0f, Phase.m_MaxUs / 1000.0f);
+			pConsole->Print(IConsole::OUTPUT_LEVEL_STANDARD, "sql", aBuf);
+		}
+
+		if(Stats.m_Errors || Stats.m_SlowQueries)
+		{
+			str_format(aBuf, sizeof(aBuf), "%-36s errors: %lld slow: %lld", "", (long long)Stats.m_Errors, (long long)Stats.m_SlowQueries);
+			pConsole->Print(IConsole::OUTPUT_LEVEL_STANDARD, "sql", aBuf);
+		}
+	}
+}
+
+bool CSqlStats::WriteJson(IOHANDLE File)
+{
+	static const char *s_apPhases[NUM_PHASES] = { "wait", "execute", "fetch" };
+	if(!File)
+		return false;
+
+	CJsonWriter Writer(File);
+	Writer.BeginObject();
+	Writer.WriteAttribute("queued");
+	Writer.WriteIntValue(NumQueued());
+	Writer.WriteAttribute("in_flight");
+	Writer.WriteIntValue(NumInFlight());
+	Writer.WriteAttribute("queries");
+	Writer.BeginArray();
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	for(const auto& [Template, Stats] : m_Templates)
+	{
+		Writer.BeginObject();
+		Writer.WriteAttribute("template");
+		Writer.WriteStrValue(Template.c_str());
+		Writer.WriteAttribute("errors");
+		Writer.WriteIntValue((int)Stats.m_Errors);
+		Writer.WriteAttribute("slow");
+		Writer.WriteIntValue((int)Stats.m_SlowQueries);
+		for(int p = 0; p < NUM_PHASES; p++)
+		{
+			const CHistogram& Phase = Stats.m_aPhases[p];
+			Writer.WriteAttribute(s_apPhases[p]);
+			Writer.BeginObject();
+			Writer.WriteAttribute("count");
+			Writer.WriteIntValue((int)Phase.m_Count);
+			Writer.WriteAttribute("avg_us");
+			Writer.WriteIntValue(Phase.m_Count ? (int)(Phase.m_SumUs / Phase.m_Count) : 0);
+			Writer.WriteAttribute("p50_us");
+			Writer.WriteIntValue(Phase.Percentile(50));
+			Writer.WriteAttribute("p95_us");
+			Writer.WriteIntValue(Phase.Percentile(95));
+			Writer.WriteAttribute("p99_us");
+			Writer.WriteIntValue(Phase.Percentile(99));
+			Writer.WriteAttribute("max_us");
+			Writer.WriteIntValue(Phase.m_MaxUs);
+			Writer.WriteAttribute("buckets");
+			Writer.BeginArray();
+			for(int i = 0; i < NUM_BUCKETS; i++)
+				Writer.WriteIntValue((int)Phase.m_aBuckets[i]);
+			Writer.EndArray();
+			Writer.EndObject();
+		}
+		Writer.EndObject();
+	}
+
+	Writer.EndArray();
+	Writer.EndObject();
+	return true;
+}
+
+std::string CSqlStats::MakeTemplate(DB Type, const char *pTableOrQuery)
+{
+	static const char *s_apTypes[] = { "SELECT", "INSERT", "UPDATE", "DELETE", "QUERY" };
+
+	// only the first word of the table, drops aliases and joins
+	const char *pEnd = pTableOrQuery;
+	while(*pEnd && *pEnd != ' ' && *pEnd != ',')
+		pEnd++;
+
+	std::string Template(s_apTypes[(int)Type]);
+	Template += ' ';
+	Template.append(pTableOrQuery, pEnd - pTableOrQuery);
+	return Template;
+}
@@ -14,7 +14,11 @@
 	#include <cppconn/resultset.h>
 #endif
 
+#include <atomic>
 #include <cstdarg>
+#include <map>
+#include <mutex>
+#include <string>
 
 using namespace sql;
 
@@ -54,6 +58,64 @@ using ResultPtr = std::unique_ptr<ResultSet>;
 using CallbackResultPtr = std::function<void(ResultPtr)>;
 using CallbackUpdatePtr = std::function<void()>;
 
+/*
+ * statistics
+ */
+class CSqlStats
+{
+public:
+	enum
+	{
+		PHASE_WAIT = 0, // waiting for the connection lock
+		PHASE_EXECUTE,
+		PHASE_FETCH, // result callback
+		NUM_PHASES,
+
+		NUM_BUCKETS = 24, // bucket i holds durations below 2^(i+1) microseconds
+	};
+
+	struct CHistogram
+	{
+		int64 m_Count;
+		int64 m_SumUs;
+		int m_MaxUs;
+		int64 m_aBuckets[NUM_BUCKETS];
+
+		void Add(int Us);
+		int Percentile(int Percent) const;
+	};
+
+	struct CTemplate
+	{
+		CHistogram m_aPhases[NUM_PHASES];
+		int64 m_Errors;
+		int64 m_SlowQueries;
+	};
+
+	// called from the query thread before it waits for the lock, returns the queue timestamp
+	int64 OnQueued();
+	// called once the lock is held, returns the start timestamp
+	int64 OnStarted();
+	void OnFinished(const std::string& Template, int64 QueuedTime, int64 StartTime, int64 ExecutedTime, bool Error);
+
+	int NumQueued() const { return m_Queued.load(); }
+	int NumInFlight() const { return m_InFlight.load(); }
+
+	void Reset();
+	void Print(class IConsole *pConsole, const char *pFilter);
+	bool WriteJson(IOHANDLE File);
+
+	// "SELECT tw_guilds", "UPDATE tw_accounts_data" etc.
+	static std::string MakeTemplate(DB Type, const char *pTableOrQuery);
+
+private:
+	std::atomic<int> m_Queued{0};
+	std::atomic<int> m_InFlight{0};
+	std::mutex m_Mutex;
+	std::map<std::string, CTemplate> m_Templates;
+};
+inline CSqlStats g_SqlStats;
+
 /*
  * class
  */
@@ -83,6 +145,12 @@ public:
 	// functions
 	void DisconnectConnectionHeap();
 
+	// reserves Count ids of the table in tw_id_sequences, returns the first one or -1
+	int ReserveIDs(const char* pTable, int Count);
+
+	// runs a schema statement before returning, used for startup migrations
+	bool ExecuteSync(const char* pQuery);
+
 	// database extraction function
 private:
 	class CResultBase
@@ -90,6 +158,7 @@ private:
 	protected:
 		friend class CConectionPool;
 		std::string m_Query;
+		std::string m_Template;
 		DB m_TypeQuery;
 	public:
 		const char* GetQueryString() const { return m_Query.c_str(); }
@@ -103,6 +172,7 @@ private:
 			std::string strQuery;
 			FORMAT_STRING_ARGS(pBuffer, strQuery, MAX_QUERY_LEN);
 			m_Query = std::string("SELECT " + std::string(pSelect) + " FROM " + std::string(pTable) + " " + strQuery + ";");
+			m_Template = CSqlStats::MakeTemplate(DB::SELECT, pTable);
 			return *this;
 		}
 
@@ -110,7 +180,9 @@ private:
 		{
 			const char* pError = nullptr;
 
+			const int64 QueuedTime = g_SqlStats.OnQueued();
 			g_SqlThreadRecursiveLock.lock();
+			const int64 StartTime = g_SqlStats.OnStarted();
 			Database->m_pDriver->threadInit();
 			Connection* pConnection = Database->GetConnection();
 			ResultPtr pResult = nullptr;
@@ -124,9 +196,11 @@ private:
 			{
 				pError = e.what();
 			}
+			const int64 ExecutedTime = time_get_impl();
 			Database->ReleaseConnection(pConnection);
 			Database->m_pDriver->threadEnd();
 			g_SqlThreadRecursiveLock.unlock();
+			g_SqlStats.OnFinished(m_Template, QueuedTime, StartTime, ExecutedTime, pError != nullptr);
 
 			if (pError != nullptr)
 				dbg_msg("SQL", "%s", pError);
@@ -136,17 +210,21 @@ private:
 
 		void AtExecute(const CallbackResultPtr& pCallbackResult)
 		{
-			auto Item = [pCallbackResult](const std::string Query)
+			auto Item = [pCallbackResult](const std::string Query, const std::string Template)
 			{
 				const char* pError = nullptr;
+				int64 ExecutedTime = 0;
 
+				const int64 QueuedTime = g_SqlStats.OnQueued();
 				g_SqlThreadRecursiveLock.lock();
+				const int64 StartTime = g_SqlStats.OnStarted();
 				Database->m_pDriver->threadInit();
 				Connection* pConnection = Database->GetConnection();
 				try
 				{
 					const std::unique_ptr<Statement> pStmt(pConnection->createStatement());
 					ResultPtr pResult(pStmt->executeQuery(Query.c_str()));
+					ExecutedTime = time_get_impl();
 					if(pCallbackResult)
 					{
 						pCallbackResult(std::move(pResult));
@@ -160,11 +238,12 @@ private:
 				Database->ReleaseConnection(pConnection);
 				Database->m_pDriver->threadEnd();
 				g_SqlThreadRecursiveLock.unlock();
+				g_SqlStats.OnFinished(Template, QueuedTime, StartTime, ExecutedTime, pError != nullptr);
 
 				if (pError != nullptr)
 					dbg_msg("SQL", "%s", pError);
 			};
-			std::thread(Item, m_Query).detach();
+			std::thread(Item, m_Query, m_Template).detach();
 		}
 	};
 
@@ -182,25 +261,30 @@ private:
 				m_Query = std::string("UPDATE " + std::string(pTable) + " SET " + strQuery + ";");
 			else if (m_TypeQuery == DB::REMOVE)
 				m_Query = std::string("DELETE FROM " + std::string(pTable) + " " + strQuery + ";");
+			m_Template = CSqlStats::MakeTemplate(m_TypeQuery, pTable);
 			return *this;
 		}
 
 		void AtExecute(const CallbackUpdatePtr& pCallbackResult, int DelayMilliseconds = 0)
 		{
-			auto Item = [pCallbackResult](const std::string Query, const int Milliseconds)
+			auto Item = [pCallbackResult](const std::string Query, const std::string Template, const int Milliseconds)
 			{
 				if (Milliseconds > 0)
 					std::this_thread::sleep_for(std::chrono::milliseconds(Milliseconds));
 
 				const char* pError = nullptr;
+				int64 ExecutedTime = 0;
 
+				const int64 QueuedTime = g_SqlStats.OnQueued();
 				g_SqlThreadRecursiveLock.lock();
+				const int64 StartTime = g_SqlStats.OnStarted();
 				Database->m_pDriver->threadInit();
 				Connection* pConnection = Database->GetConnection();
 				try
 				{
 					const std::unique_ptr<Statement> pStmt(pConnection->createStatement());
 					pStmt->execute(Query.c_str());
+					ExecutedTime = time_get_impl();
 					if(pCallbackResult)
 					{
 						pCallbackResult();
@@ -214,11 +298,12 @@ private:
 				Database->ReleaseConnection(pConnection);
 				Database->m_pDriver->threadEnd();
 				g_SqlThreadRecursiveLock.unlock();
+				g_SqlStats.OnFinished(Template, QueuedTime, StartTime, ExecutedTime, pError != nullptr);
 
 				if (pError != nullptr)
 					dbg_msg("SQL", "%s", pError);
 			};
-			std::thread(Item, m_Query, DelayMilliseconds).detach();
+			std::thread(Item, m_Query, m_Template, DelayMilliseconds).detach();
 		}
 		void Execute(int DelayMilliseconds = 0) { return AtExecute(nullptr, DelayMilliseconds); }
 	};
@@ -231,6 +316,7 @@ private:
 			std::string strQuery;
 			FORMAT_STRING_ARGS(pBuffer, strQuery, MAX_QUERY_LEN);
 			m_Query = std::string(strQuery + ";");
+			m_Template = CSqlStats::MakeTemplate(DB::OTHER, strQuery.c_str());
 			return *this;
 		}
 	};
@@ -242,6 +328,7 @@ private:
 	{
 		CResultSelect Data;
 		Data.m_Query = std::string("SELECT " + std::string(pSelect) + " FROM " + std::string(pTable) + " " + strQuery + ";");
+		Data.m_Template = CSqlStats::MakeTemplate(Type, pTable);
 		Data.m_TypeQuery = Type;
 
 		return std::make_shared<CResultSelect>(Data);
@@ -276,6 +363,7 @@ private:
 	{
 		CResultQueryCustom Data;
 		Data.m_Query = std::string(strQuery + ";");
+		Data.m_Template = CSqlStats::MakeTemplate(Type, strQuery.c_str());
 		Data.m_TypeQuery = Type;
 
 		return std::make_shared<CResultQueryCustom>(Data);
@@ -316,6 +404,7 @@ private:
 			Data.m_Query = std::string("UPDATE " + std::string(pTable) + " SET " + strQuery + ";");
 		else if(Type == DB::REMOVE)
 			Data.m_Query = std::string("DELETE FROM " + std::string(pTable) + " " + strQuery + ";");
+		Data.m_Template = CSqlStats::MakeTemplate(Type, pTable);
 
 		return std::make_shared<CResultQuery>(Data);
 	}
@@ -115,6 +115,10 @@ MACRO_CONFIG_INT(SvFastDownload, sv_fast_download, 1, 0, 1, CFGFLAG_SERVER, "Ena
 MACRO_CONFIG_INT(SvServerInfoPerSecond, sv_server_info_per_second, 50, 0, 10000, CFGFLAG_SERVER, "Maximum number of complete server info responses that are sent out per second (0 for no limit)")
 MACRO_CONFIG_INT(SvVanConnPerSecond, sv_van_conn_per_second, 10, 0, 10000, CFGFLAG_SERVER, "Antispoof specific ratelimit (0 for no limit)")
 MACRO_CONFIG_INT(SvVanillaAntiSpoof, sv_vanilla_antispoof, 0, 0, 1, CFGFLAG_SERVER, "Enable vanilla Antispoof")
+MACRO_CONFIG_INT(SvProfiler, sv_profiler, 1, 0, 1, CFGFLAG_SERVER, "Measure time spent in tick phases, worlds and components")
+MACRO_CONFIG_INT(SvProfilerDumpInterval, sv_profiler_dump_interval, 0, 0, 3600, CFGFLAG_SERVER, "Write tick profiler statistics every n seconds (0 = off)")
+MACRO_CONFIG_STR(SvProfilerDumpFile, sv_profiler_dump_file, 128, "profiler.json", CFGFLAG_SERVER, "File the tick profiler statistics are written to")
+MACRO_CONFIG_INT(SvNetThread, sv_net_thread, 0, 0, 1, CFGFLAG_SERVER, "Receive packets on a separate thread so packet bursts don't delay ticks")
 
 MACRO_CONFIG_STR(EcBindaddr, ec_bindaddr, 128, "localhost", CFGFLAG_SAVE|CFGFLAG_ECON, "Address to bind the external console to. Anything but 'localhost' is dangerous")
 MACRO_CONFIG_INT(EcPort, ec_port, 0, 0, 0, CFGFLAG_SAVE|CFGFLAG_ECON, "Port to use for the external console")
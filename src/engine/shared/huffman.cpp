@@ -145,73 +145,95 @@ void CHuffman::Init(const unsigned* pFrequencies)
 			m_apDecodeLut[i] = pNode;
 	}
 
+	BuildDecodeTable();
 }
 
-//***************************************************************
-int CHuffman::Compress(const void* pInput, int InputSize, void* pOutput, int OutputSize)
+void CHuffman::BuildDecodeTable()
 {
-	// this macro loads a symbol for a byte into bits and bitcount
-#define HUFFMAN_MACRO_LOADSYMBOL(Sym) \
-	Bits |= m_aNodes[Sym].m_Bits << Bitcount; \
-	Bitcount += m_aNodes[Sym].m_NumBits;
-
-	// this macro writes the symbol stored in bits and bitcount to the dst pointer
-#define HUFFMAN_MACRO_WRITE() \
-	while(Bitcount >= 8) \
-	{ \
-		*pDst++ = (unsigned char)(Bits&0xff); \
-		if(pDst == pDstEnd) \
-			return -1; \
-		Bits >>= 8; \
-		Bitcount -= 8; \
+	for (int i = 0; i < HUFFMAN_DECODE_SIZE; i++)
+	{
+		CDecodeEntry* pEntry = &m_aDecodeTable[i];
+		unsigned Bits = i;
+		unsigned Consumed = 0;
+
+		// walk as many whole symbols as the index bits hold
+		while (pEntry->m_NumSymbols < HUFFMAN_DECODE_MAXSYMBOLS && !pEntry->m_Eof)
+		{
+			CNode* pNode = m_pStartNode;
+			unsigned Depth = 0;
+			while (!pNode->m_NumBits && Consumed + Depth < HUFFMAN_DECODE_BITS)
+			{
+				pNode = &m_aNodes[pNode->m_aLeafs[(Bits >> Depth) & 1]];
+				Depth++;
+			}
+
+			if (!pNode->m_NumBits)
+				break;
+
+			Bits >>= Depth;
+			Consumed += Depth;
+			if (pNode == &m_aNodes[HUFFMAN_EOF_SYMBOL])
+				pEntry->m_Eof = 1;
+			else
+				pEntry->m_aSymbols[pEntry->m_NumSymbols++] = pNode->m_Symbol;
+		}
+
+		pEntry->m_NumBits = Consumed;
 	}
+}
 
+//***************************************************************
+int CHuffman::Compress(const void* pInput, int InputSize, void* pOutput, int OutputSize)
+{
 	// setup buffer pointers
 	const unsigned char* pSrc = (const unsigned char*)pInput;
 	const unsigned char* pSrcEnd = pSrc + InputSize;
 	unsigned char* pDst = (unsigned char*)pOutput;
 	unsigned char* pDstEnd = pDst + OutputSize;
 
-	// symbol variables
-	unsigned Bits = 0;
+	// symbol variables, codes are at most 32 bits so 64 bits always hold a pending word plus a symbol
+	uint64_t Bits = 0;
 	unsigned Bitcount = 0;
 
-	// make sure that we have data that we want to compress
-	if (InputSize)
+	// the output may never reach the end before the final byte
+	while (pSrc != pSrcEnd)
 	{
-		// {A} load the first symbol
-		int Symbol = *pSrc++;
+		const CNode& Node = m_aNodes[*pSrc++];
+		Bits |= (uint64_t)Node.m_Bits << Bitcount;
+		Bitcount += Node.m_NumBits;
 
-		while (pSrc != pSrcEnd)
+		if (Bitcount >= 32)
 		{
-			// {B} load the symbol
-			HUFFMAN_MACRO_LOADSYMBOL(Symbol)
-
-				// {C} fetch next symbol, this is done here because it will reduce dependency in the code
-				Symbol = *pSrc++;
-
-			// {B} write the symbol loaded at
-			HUFFMAN_MACRO_WRITE()
+			if (pDstEnd - pDst <= 4)
+				return -1;
+
+			pDst[0] = (unsigned char)Bits;
+			pDst[1] = (unsigned char)(Bits >> 8);
+			pDst[2] = (unsigned char)(Bits >> 16);
+			pDst[3] = (unsigned char)(Bits >> 24);
+			pDst += 4;
+			Bits >>= 32;
+			Bitcount -= 32;
 		}
-
-		// write the last symbol loaded from {C} or {A} in the case of only 1 byte input buffer
-		HUFFMAN_MACRO_LOADSYMBOL(Symbol)
-			HUFFMAN_MACRO_WRITE()
 	}
 
 	// write EOF symbol
-	HUFFMAN_MACRO_LOADSYMBOL(HUFFMAN_EOF_SYMBOL)
-		HUFFMAN_MACRO_WRITE()
+	Bits |= (uint64_t)m_aNodes[HUFFMAN_EOF_SYMBOL].m_Bits << Bitcount;
+	Bitcount += m_aNodes[HUFFMAN_EOF_SYMBOL].m_NumBits;
+	while (Bitcount >= 8)
+	{
+		*pDst++ = (unsigned char)Bits;
+		if (pDst == pDstEnd)
+			return -1;
+		Bits >>= 8;
+		Bitcount -= 8;
+	}
 
-		// write out the last bits
-		* pDst++ = Bits;
+	// write out the last bits
+	*pDst++ = (unsigned char)Bits;
 
 	// return the size of the output
 	return (int)(pDst - (const unsigned char*)pOutput);
-
-	// remove macros
-#undef HUFFMAN_MACRO_LOADSYMBOL
-#undef HUFFMAN_MACRO_WRITE
 }
 
 //***************************************************************
@@ -231,21 +253,33 @@ int CHuffman::Decompress(const void* pInput, int InputSize, void* pOutput, int O
 
 	while (1)
 	{
-		// {A} try to load a node now, this will reduce dependency at location {D}
-		pNode = 0;
-		if (Bitcount >= HUFFMAN_LUTBITS)
-			pNode = m_apDecodeLut[Bits & HUFFMAN_LUTMASK];
-
-		// {B} fill with new bits
+		// {A} fill with new bits
 		while (Bitcount < 24 && pSrc != pSrcEnd)
 		{
 			Bits |= (*pSrc++) << Bitcount;
 			Bitcount += 8;
 		}
 
-		// {C} load symbol now if we didn't that earlier at location {A}
-		if (!pNode)
-			pNode = m_apDecodeLut[Bits & HUFFMAN_LUTMASK];
+		// {B} fast path, emit every symbol the decode table resolved for these bits
+		if (Bitcount >= HUFFMAN_DECODE_BITS)
+		{
+			const CDecodeEntry& Entry = m_aDecodeTable[Bits & HUFFMAN_DECODE_MASK];
+			if (Entry.m_NumBits && pDstEnd - pDst >= Entry.m_NumSymbols)
+			{
+				for (int i = 0; i < Entry.m_NumSymbols; i++)
+					pDst[i] = Entry.m_aSymbols[i];
+				pDst += Entry.m_NumSymbols;
+				Bits >>= Entry.m_NumBits;
+				Bitcount -= Entry.m_NumBits;
+
+				if (Entry.m_Eof)
+					break;
+				continue;
+			}
+		}
+
+		// {C} slow path, one symbol through the lut and the tree
+		pNode = m_apDecodeLut[Bits & HUFFMAN_LUTMASK];
 
 		if (!pNode)
 			return -1;
@@ -14,7 +14,12 @@ class CHuffman
 
 		HUFFMAN_LUTBITS = 10,
 		HUFFMAN_LUTSIZE = (1 << HUFFMAN_LUTBITS),
-		HUFFMAN_LUTMASK = (HUFFMAN_LUTSIZE - 1)
+		HUFFMAN_LUTMASK = (HUFFMAN_LUTSIZE - 1),
+
+		HUFFMAN_DECODE_BITS = 12,
+		HUFFMAN_DECODE_SIZE = (1 << HUFFMAN_DECODE_BITS),
+		HUFFMAN_DECODE_MASK = (HUFFMAN_DECODE_SIZE - 1),
+		HUFFMAN_DECODE_MAXSYMBOLS = 5
 	};
 
 	struct CNode
@@ -30,13 +35,24 @@ class CHuffman
 		unsigned char m_Symbol;
 	};
 
+	// every symbol that fully fits into the next HUFFMAN_DECODE_BITS bits, decoded at once
+	struct CDecodeEntry
+	{
+		unsigned char m_aSymbols[HUFFMAN_DECODE_MAXSYMBOLS];
+		unsigned char m_NumSymbols;
+		unsigned char m_NumBits; // 0 if no complete symbol fits, use the tree then
+		unsigned char m_Eof; // the bits end with the eof symbol
+	};
+
 	CNode m_aNodes[HUFFMAN_MAX_NODES];
 	CNode* m_apDecodeLut[HUFFMAN_LUTSIZE];
+	CDecodeEntry m_aDecodeTable[HUFFMAN_DECODE_SIZE];
 	CNode* m_pStartNode;
 	int m_NumNodes;
 
 	void Setbits_r(CNode* pNode, int Bits, unsigned Depth);
 	void ConstructTree(const unsigned* pFrequencies);
+	void BuildDecodeTable();
 
 public:
 	/*
@@ -10,6 +10,8 @@
 
 #include <engine/message.h>
 
+#include <atomic>
+
 /*
 
 CURRENT:
@@ -290,13 +292,66 @@ public:
 	int FetchChunk(CNetChunk *pChunk);
 };
 
+// lock-free single producer / single consumer queue of raw datagrams
+class CNetPacketQueue
+{
+public:
+	enum
+	{
+		NUM_PACKETS = 1024,
+	};
+
+	struct CPacket
+	{
+		NETADDR m_Addr;
+		int m_DataSize;
+		unsigned char m_aData[NET_MAX_PACKETSIZE];
+	};
+
+private:
+	CPacket m_aPackets[NUM_PACKETS];
+	std::atomic<unsigned> m_ReadIndex{0};
+	std::atomic<unsigned> m_WriteIndex{0};
+
+public:
+	// producer side, returns nullptr when the queue is full
+	CPacket *Reserve()
+	{
+		const unsigned Write = m_WriteIndex.load(std::memory_order_relaxed);
+		if(Write - m_ReadIndex.load(std::memory_order_acquire) >= NUM_PACKETS)
+			return nullptr;
+		return &m_aPackets[Write % NUM_PACKETS];
+	}
+	void Commit() { m_WriteIndex.fetch_add(1, std::memory_order_release); }
+
+	// consumer side, returns nullptr when the queue is empty
+	const CPacket *Front()
+	{
+		const unsigned Read = m_ReadIndex.load(std::memory_order_relaxed);
+		if(Read == m_WriteIndex.load(std::memory_order_acquire))
+			return nullptr;
+		return &m_aPackets[Read % NUM_PACKETS];
+	}
+	void Pop() { m_ReadIndex.fetch_add(1, std::memory_order_release); }
+	bool Empty() const { return m_ReadIndex.load(std::memory_order_acquire) == m_WriteIndex.load(std::memory_order_acquire); }
+};
+
 // server side
 class CNetServer
 {
+	enum
+	{
+		NET_SLOT_HASH_SIZE = NET_MAX_CLIENTS * 2,
+	};
+
 	struct CSlot
 	{
 	public:
 		CNetConnection m_Connection;
+
+		// address index chain
+		int m_HashBucket;
+		int m_HashNext;
 	};
 
 	struct CSpamConn
@@ -311,6 +366,7 @@ class CNetServer
 	MMSGS m_MMSGS;
 	class CNetBan *m_pNetBan;
 	CSlot m_aSlots[NET_MAX_CLIENTS];
+	int m_aSlotHash[NET_SLOT_HASH_SIZE];
 	int m_MaxClients;
 	int m_MaxClientsPerIP;
 
@@ -332,12 +388,20 @@ class CNetServer
 
 	CNetRecvUnpacker m_RecvUnpacker;
 
+	// optional receive thread, owns the socket reads while running
+	class CNetRecvThread *m_pRecvThread = nullptr;
+	static void RecvThread(void *pUser);
+	int RecvPacket(NETADDR *pAddr, unsigned char **ppData);
+
 	void OnTokenCtrlMsg(NETADDR &Addr, int ControlMsg, const CNetPacketConstruct &Packet);
 	int OnSixupCtrlMsg(NETADDR &Addr, CNetChunk *pChunk, int ControlMsg, const CNetPacketConstruct &Packet, SECURITY_TOKEN &ResponseToken, SECURITY_TOKEN Token);
 	void OnPreConnMsg(NETADDR &Addr, CNetPacketConstruct &Packet);
 	void OnConnCtrlMsg(NETADDR &Addr, int ClientID, int ControlMsg, const CNetPacketConstruct &Packet);
 	bool ClientExists(const NETADDR &Addr) { return GetClientSlot(Addr) != -1; };
 	int GetClientSlot(const NETADDR &Addr);
+	static int SlotHash(const NETADDR &Addr);
+	void HashSlot(int Slot);
+	void UnhashSlot(int Slot);
 	void SendControl(NETADDR &Addr, int ControlMsg, const void *pExtra, int ExtraSize, SECURITY_TOKEN SecurityToken);
 
 	int TryAcceptClient(NETADDR &Addr, SECURITY_TOKEN SecurityToken, bool VanillaAuth = false, bool Sixup = false, SECURITY_TOKEN Token = 0);
@@ -358,6 +422,12 @@ public:
 	int Send(CNetChunk *pChunk);
 	int Update();
 
+	// receive thread
+	bool StartRecvThread();
+	void StopRecvThread();
+	bool HasRecvThread() const { return m_pRecvThread != nullptr; }
+	void WaitForData(int TimeUs);
+
 	//
 	int Drop(int ClientID, const char *pReason);
 
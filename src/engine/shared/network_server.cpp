@@ -12,6 +12,10 @@
 #include <engine/shared/protocol.h>
 #include <generated/protocol.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 const int DummyMapCrc = 0x6c760ac4;
 unsigned char g_aDummyMapData[] = {
 	0x44, 0x41, 0x54, 0x41, 0x04, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00,
@@ -77,7 +81,13 @@ bool CNetServer::Open(NETADDR BindAddr, CNetBan *pNetBan, int MaxClients, int Ma
 	secure_random_fill(m_aSecurityTokenSeed, sizeof(m_aSecurityTokenSeed));
 
 	for(auto &Slot : m_aSlots)
+	{
 		Slot.m_Connection.Init(m_Socket, true);
+		Slot.m_HashBucket = -1;
+		Slot.m_HashNext = -1;
+	}
+	for(auto &Bucket : m_aSlotHash)
+		Bucket = -1;
 
 	net_init_mmsgs(&m_MMSGS);
 
@@ -105,9 +115,127 @@ int CNetServer::SetCallbacks(NETFUNC_NEWCLIENT pfnNewClient, NETFUNC_NEWCLIENT_N
 int CNetServer::Close()
 {
 	// TODO: implement me
+	StopRecvThread();
 	return 0;
 }
 
+class CNetRecvThread
+{
+public:
+	CNetPacketQueue m_Queue;
+	void *m_pThread = nullptr;
+	std::atomic<bool> m_Shutdown{false};
+	std::atomic<unsigned> m_NumDropped{0};
+
+	std::mutex m_WaitMutex;
+	std::condition_variable m_WaitCond;
+};
+
+void CNetServer::RecvThread(void *pUser)
+{
+	CNetServer *pThis = (CNetServer *)pUser;
+	CNetRecvThread *pRecv = pThis->m_pRecvThread;
+	unsigned char aBuffer[NET_MAX_PACKETSIZE];
+
+	while(!pRecv->m_Shutdown.load(std::memory_order_relaxed))
+	{
+		// wake up at least every 100ms to notice shutdown
+		net_socket_read_wait(pThis->m_Socket, 100000);
+
+		bool Received = false;
+		while(1)
+		{
+			NETADDR Addr;
+			unsigned char *pData;
+			int Bytes = net_udp_recv(pThis->m_Socket, &Addr, aBuffer, NET_MAX_PACKETSIZE, &pThis->m_MMSGS, &pData);
+			if(Bytes <= 0)
+				break;
+
+			CNetPacketQueue::CPacket *pPacket = pRecv->m_Queue.Reserve();
+			if(!pPacket)
+			{
+				// the game thread is behind, drop like a full socket buffer would
+				pRecv->m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+
+			pPacket->m_Addr = Addr;
+			pPacket->m_DataSize = min(Bytes, (int)NET_MAX_PACKETSIZE);
+			mem_copy(pPacket->m_aData, pData, pPacket->m_DataSize);
+			pRecv->m_Queue.Commit();
+			Received = true;
+		}
+
+		if(Received)
+		{
+			std::lock_guard<std::mutex> Lock(pRecv->m_WaitMutex);
+			pRecv->m_WaitCond.notify_one();
+		}
+	}
+}
+
+bool CNetServer::StartRecvThread()
+{
+	if(m_pRecvThread)
+		return true;
+
+	m_pRecvThread = new CNetRecvThread();
+	m_pRecvThread->m_pThread = thread_init(RecvThread, this, "net recv");
+	if(!m_pRecvThread->m_pThread)
+	{
+		delete m_pRecvThread;
+		m_pRecvThread = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void CNetServer::StopRecvThread()
+{
+	if(!m_pRecvThread)
+		return;
+
+	m_pRecvThread->m_Shutdown.store(true, std::memory_order_relaxed);
+	thread_wait(m_pRecvThread->m_pThread);
+
+	const unsigned NumDropped = m_pRecvThread->m_NumDropped.load();
+	if(NumDropped)
+		dbg_msg("netserver", "receive queue overflowed, %u packets dropped", NumDropped);
+
+	delete m_pRecvThread;
+	m_pRecvThread = nullptr;
+}
+
+void CNetServer::WaitForData(int TimeUs)
+{
+	if(!m_pRecvThread)
+	{
+		net_socket_read_wait(m_Socket, TimeUs);
+		return;
+	}
+
+	std::unique_lock<std::mutex> Lock(m_pRecvThread->m_WaitMutex);
+	m_pRecvThread->m_WaitCond.wait_for(Lock, std::chrono::microseconds(TimeUs), [this]() { return !m_pRecvThread->m_Queue.Empty(); });
+}
+
+int CNetServer::RecvPacket(NETADDR *pAddr, unsigned char **ppData)
+{
+	if(!m_pRecvThread)
+		return net_udp_recv(m_Socket, pAddr, m_RecvUnpacker.m_aBuffer, NET_MAX_PACKETSIZE, &m_MMSGS, ppData);
+
+	const CNetPacketQueue::CPacket *pPacket = m_pRecvThread->m_Queue.Front();
+	if(!pPacket)
+		return 0;
+
+	// copy out so the slot can be reused while the packet is processed
+	*pAddr = pPacket->m_Addr;
+	const int Bytes = pPacket->m_DataSize;
+	mem_copy(m_RecvUnpacker.m_aBuffer, pPacket->m_aData, Bytes);
+	*ppData = m_RecvUnpacker.m_aBuffer;
+	m_pRecvThread->m_Queue.Pop();
+	return Bytes;
+}
+
 int CNetServer::Drop(int ClientID, const char *pReason)
 {
 	// TODO: insert lots of checks here
@@ -122,6 +250,7 @@ int CNetServer::Drop(int ClientID, const char *pReason)
 		m_pfnDelClient(ClientID, pReason, m_pUser);
 
 	m_aSlots[ClientID].m_Connection.Disconnect(pReason);
+	UnhashSlot(ClientID);
 
 	return 0;
 }
@@ -252,6 +381,7 @@ int CNetServer::TryAcceptClient(NETADDR &Addr, SECURITY_TOKEN SecurityToken, boo
 
 	// init connection slot
 	m_aSlots[Slot].m_Connection.DirectInit(Addr, SecurityToken, Token, Sixup);
+	HashSlot(Slot);
 
 	if(VanillaAuth)
 	{
@@ -578,22 +708,61 @@ int CNetServer::OnSixupCtrlMsg(NETADDR &Addr, CNetChunk *pChunk, int ControlMsg,
 	return 0;
 }
 
-int CNetServer::GetClientSlot(const NETADDR &Addr)
+int CNetServer::SlotHash(const NETADDR &Addr)
 {
-	int Slot = -1;
+	// FNV-1a over the fields compared by net_addr_comp, padding excluded
+	unsigned Hash = 2166136261u;
+	auto Mix = [&Hash](const unsigned char *pData, int Size) {
+		for(int i = 0; i < Size; i++)
+			Hash = (Hash ^ pData[i]) * 16777619u;
+	};
+	Mix((const unsigned char *)&Addr.type, sizeof(Addr.type));
+	Mix(Addr.ip, sizeof(Addr.ip));
+	Mix((const unsigned char *)&Addr.port, sizeof(Addr.port));
+	return Hash % NET_SLOT_HASH_SIZE;
+}
 
-	for(int i = 0; i < MaxClients(); i++)
+void CNetServer::HashSlot(int Slot)
+{
+	UnhashSlot(Slot);
+
+	const int Bucket = SlotHash(*m_aSlots[Slot].m_Connection.PeerAddress());
+	m_aSlots[Slot].m_HashBucket = Bucket;
+	m_aSlots[Slot].m_HashNext = m_aSlotHash[Bucket];
+	m_aSlotHash[Bucket] = Slot;
+}
+
+void CNetServer::UnhashSlot(int Slot)
+{
+	const int Bucket = m_aSlots[Slot].m_HashBucket;
+	if(Bucket == -1)
+		return;
+
+	int *pLink = &m_aSlotHash[Bucket];
+	while(*pLink != -1 && *pLink != Slot)
+		pLink = &m_aSlots[*pLink].m_HashNext;
+	if(*pLink == Slot)
+		*pLink = m_aSlots[Slot].m_HashNext;
+
+	m_aSlots[Slot].m_HashBucket = -1;
+	m_aSlots[Slot].m_HashNext = -1;
+}
+
+int CNetServer::GetClientSlot(const NETADDR &Addr)
+{
+	// slots are indexed by the address they got on accept or timeout restore,
+	// the connection state is still checked since it changes without us
+	for(int i = m_aSlotHash[SlotHash(Addr)]; i != -1; i = m_aSlots[i].m_HashNext)
 	{
 		if(m_aSlots[i].m_Connection.State() != NET_CONNSTATE_OFFLINE &&
 			m_aSlots[i].m_Connection.State() != NET_CONNSTATE_ERROR &&
 			net_addr_comp(m_aSlots[i].m_Connection.PeerAddress(), &Addr) == 0)
-
 		{
-			Slot = i;
+			return i;
 		}
 	}
 
-	return Slot;
+	return -1;
 }
 
 static bool IsDDNetControlMsg(const CNetPacketConstruct *pPacket)
@@ -630,7 +799,7 @@ int CNetServer::Recv(CNetChunk *pChunk, SECURITY_TOKEN *pResponseToken)
 
 		// TODO: empty the recvinfo
 		unsigned char *pData;
-		int Bytes = net_udp_recv(m_Socket, &Addr, m_RecvUnpacker.m_aBuffer, NET_MAX_PACKETSIZE, &m_MMSGS, &pData);
+		int Bytes = RecvPacket(&Addr, &pData);
 
 		// no more packets for now
 		if(Bytes <= 0)
@@ -800,6 +969,8 @@ bool CNetServer::SetTimedOut(int ClientID, int OrigID)
 
 	m_aSlots[ClientID].m_Connection.SetTimedOut(ClientAddr(OrigID), m_aSlots[OrigID].m_Connection.SeqSequence(), m_aSlots[OrigID].m_Connection.AckSequence(), m_aSlots[OrigID].m_Connection.SecurityToken(), m_aSlots[OrigID].m_Connection.ResendBuffer(), m_aSlots[OrigID].m_Connection.m_Sixup);
 	m_aSlots[OrigID].m_Connection.Reset();
+	UnhashSlot(OrigID);
+	HashSlot(ClientID);
 	return true;
 }
 
@@ -0,0 +1,143 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#include "profiler.h"
+
+#include "jsonwriter.h"
+
+#include <algorithm>
+
+CTickProfiler::CTickProfiler()
+{
+	m_NumSections = 0;
+	m_Enabled = true;
+	Reset();
+}
+
+void CTickProfiler::SetEnabled(bool Enabled)
+{
+	if(m_Enabled != Enabled)
+		Reset();
+	m_Enabled = Enabled;
+}
+
+void CTickProfiler::Reset()
+{
+	for(int i = 0; i < m_NumSections; i++)
+	{
+		m_aSections[i].m_Current = 0;
+		m_aSections[i].m_Hit = false;
+		m_aSections[i].m_NumSamples = 0;
+		m_aSections[i].m_SamplePos = 0;
+	}
+}
+
+int CTickProfiler::RegisterSection(const char *pName)
+{
+	for(int i = 0; i < m_NumSections; i++)
+	{
+		if(str_comp(m_aSections[i].m_aName, pName) == 0)
+			return i;
+	}
+
+	if(m_NumSections >= MAX_SECTIONS)
+	{
+		dbg_msg("profiler", "can't register section '%s', limit of %d reached", pName, (int)MAX_SECTIONS);
+		return -1;
+	}
+
+	CSection *pSection = &m_aSections[m_NumSections];
+	str_copy(pSection->m_aName, pName, sizeof(pSection->m_aName));
+	pSection->m_Current = 0;
+	pSection->m_Hit = false;
+	pSection->m_NumSamples = 0;
+	pSection->m_SamplePos = 0;
+	return m_NumSections++;
+}
+
+void CTickProfiler::OnTickEnd()
+{
+	if(!m_Enabled)
+		return;
+
+	const int64 Freq = time_freq();
+	for(int i = 0; i < m_NumSections; i++)
+	{
+		CSection *pSection = &m_aSections[i];
+		if(!pSection->m_Hit)
+			continue;
+
+		pSection->m_aSamplesUs[pSection->m_SamplePos] = (int)(pSection->m_Current * 1000000 / Freq);
+		pSection->m_SamplePos = (pSection->m_SamplePos + 1) % WINDOW_TICKS;
+		if(pSection->m_NumSamples < WINDOW_TICKS)
+			pSection->m_NumSamples++;
+
+		pSection->m_Current = 0;
+		pSection->m_Hit = false;
+	}
+}
+
+void CTickProfiler::GetStats(int Section, CStats *pStats) const
+{
+	mem_zero(pStats, sizeof(*pStats));
+
+	const CSection *pSection = &m_aSections[Section];
+	const int Num = pSection->m_NumSamples;
+	if(Num == 0)
+		return;
+
+	int aSorted[WINDOW_TICKS];
+	int64 Sum = 0;
+	for(int i = 0; i < Num; i++)
+	{
+		aSorted[i] = pSection->m_aSamplesUs[i];
+		Sum += aSorted[i];
+	}
+	std::sort(aSorted, aSorted + Num);
+
+	pStats->m_NumSamples = Num;
+	pStats->m_AvgUs = (int)(Sum / Num);
+	pStats->m_P50Us = aSorted[(Num - 1) * 50 / 100];
+	pStats->m_P95Us = aSorted[(Num - 1) * 95 / 100];
+	pStats->m_P99Us = aSorted[(Num - 1) * 99 / 100];
+	pStats->m_MaxUs = aSorted[Num - 1];
+}
+
+bool CTickProfiler::WriteJson(IOHANDLE File, int Tick) const
+{
+	if(!File)
+		return false;
+
+	CJsonWriter Writer(File);
+	Writer.BeginObject();
+	Writer.WriteAttribute("tick");
+	Writer.WriteIntValue(Tick);
+	Writer.WriteAttribute("window_ticks");
+	Writer.WriteIntValue(WINDOW_TICKS);
+	Writer.WriteAttribute("sections");
+	Writer.BeginArray();
+	for(int i = 0; i < m_NumSections; i++)
+	{
+		CStats Stats;
+		GetStats(i, &Stats);
+
+		Writer.BeginObject();
+		Writer.WriteAttribute("name");
+		Writer.WriteStrValue(m_aSections[i].m_aName);
+		Writer.WriteAttribute("samples");
+		Writer.WriteIntValue(Stats.m_NumSamples);
+		Writer.WriteAttribute("avg_us");
+		Writer.WriteIntValue(Stats.m_AvgUs);
+		Writer.WriteAttribute("p50_us");
+		Writer.WriteIntValue(Stats.m_P50Us);
+		Writer.WriteAttribute("p95_us");
+		Writer.WriteIntValue(Stats.m_P95Us);
+		Writer.WriteAttribute("p99_us");
+		Writer.WriteIntValue(Stats.m_P99Us);
+		Writer.WriteAttribute("max_us");
+		Writer.WriteIntValue(Stats.m_MaxUs);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+	return true;
+}
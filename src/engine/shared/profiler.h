@@ -0,0 +1,101 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#ifndef ENGINE_SHARED_PROFILER_H
+#define ENGINE_SHARED_PROFILER_H
+
+#include <base/system.h>
+
+#include "protocol.h"
+
+/*
+	Per-tick timing of named sections. Every section sums up the time spent in it
+	during one tick, the last WINDOW_TICKS tick totals are kept for percentiles.
+	Only meant to be used from the game thread.
+*/
+class CTickProfiler
+{
+public:
+	enum
+	{
+		// every world registers its tick, snap, entity, player and mmo component sections
+		SECTIONS_PER_WORLD = 32,
+		MAX_SECTIONS = 16 + ENGINE_MAX_WORLDS * SECTIONS_PER_WORLD,
+		MAX_NAME_LENGTH = 48,
+		WINDOW_TICKS = 250, // 5 seconds at 50 ticks per second
+	};
+
+	struct CStats
+	{
+		int m_NumSamples;
+		int m_AvgUs;
+		int m_P50Us;
+		int m_P95Us;
+		int m_P99Us;
+		int m_MaxUs;
+	};
+
+private:
+	struct CSection
+	{
+		char m_aName[MAX_NAME_LENGTH];
+		int64 m_Current;
+		bool m_Hit;
+		int m_aSamplesUs[WINDOW_TICKS];
+		int m_NumSamples;
+		int m_SamplePos;
+	};
+
+	CSection m_aSections[MAX_SECTIONS];
+	int m_NumSections;
+	bool m_Enabled;
+
+public:
+	CTickProfiler();
+
+	bool IsEnabled() const { return m_Enabled; }
+	void SetEnabled(bool Enabled);
+	void Reset();
+
+	// returns the same id for the same name, -1 if the table is full
+	int RegisterSection(const char *pName);
+	int NumSections() const { return m_NumSections; }
+	const char *SectionName(int Section) const { return m_aSections[Section].m_aName; }
+
+	void Add(int Section, int64 Time)
+	{
+		if(Section < 0)
+			return;
+		m_aSections[Section].m_Current += Time;
+		m_aSections[Section].m_Hit = true;
+	}
+
+	// closes the current tick, sections that were not entered don't get a sample
+	void OnTickEnd();
+
+	void GetStats(int Section, CStats *pStats) const;
+	bool WriteJson(IOHANDLE File, int Tick) const;
+};
+
+class CProfileScope
+{
+	CTickProfiler *m_pProfiler;
+	int m_Section;
+	int64 m_Start;
+
+public:
+	CProfileScope(CTickProfiler *pProfiler, int Section)
+	{
+		m_pProfiler = pProfiler && pProfiler->IsEnabled() && Section >= 0 ? pProfiler : nullptr;
+		m_Section = Section;
+		m_Start = m_pProfiler ? time_get() : 0;
+	}
+	~CProfileScope()
+	{
+		if(m_pProfiler)
+			m_pProfiler->Add(m_Section, time_get() - m_Start);
+	}
+	CProfileScope(const CProfileScope &) = delete;
+	CProfileScope &operator=(const CProfileScope &) = delete;
+};
+
+#endif
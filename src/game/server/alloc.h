@@ -3,6 +3,10 @@
 #ifndef GAME_SERVER_ALLOC_H
 #define GAME_SERVER_ALLOC_H
 
+#include <base/system.h>
+
+#include <vector>
+
 #define MACRO_ALLOC_HEAP() \
 	public: \
 	void *operator new(size_t Size) \
@@ -50,4 +54,109 @@
 		mem_zero(ms_PoolData##POOLTYPE[id], sizeof(POOLTYPE)); \
 	}
 
+/*
+	Free list allocator for the entities that are created and destroyed
+	all the time (drops, projectiles, texts). Memory is taken in slabs and
+	kept until exit, a freed object goes back to the list of its type.
+	Entities are only created and destroyed on the game thread.
+*/
+class CAllocPool
+{
+	struct CFreeSlot
+	{
+		CFreeSlot *m_pNext;
+	};
+
+	const char *m_pName;
+	int m_ObjectSize;
+	int m_SlabSize;
+	int m_Live;
+	int m_Peak;
+	CFreeSlot *m_pFirstFree;
+	std::vector<char *> m_apSlabs;
+	CAllocPool *m_pNextPool;
+
+	static CAllocPool *&FirstPool()
+	{
+		static CAllocPool *s_pFirst = nullptr;
+		return s_pFirst;
+	}
+
+	void Grow()
+	{
+		char *pSlab = (char *)mem_alloc(m_ObjectSize * m_SlabSize, 1);
+		m_apSlabs.push_back(pSlab);
+		for(int i = m_SlabSize - 1; i >= 0; i--)
+		{
+			CFreeSlot *pSlot = (CFreeSlot *)(pSlab + i * m_ObjectSize);
+			pSlot->m_pNext = m_pFirstFree;
+			m_pFirstFree = pSlot;
+		}
+	}
+
+public:
+	CAllocPool(const char *pName, int ObjectSize, int SlabSize)
+		: m_pName(pName), m_ObjectSize(ObjectSize), m_SlabSize(SlabSize), m_Live(0), m_Peak(0), m_pFirstFree(nullptr)
+	{
+		m_pNextPool = FirstPool();
+		FirstPool() = this;
+	}
+
+	~CAllocPool()
+	{
+		for(char *pSlab : m_apSlabs)
+			mem_free(pSlab);
+	}
+
+	void *Alloc()
+	{
+		if(!m_pFirstFree)
+			Grow();
+
+		void *p = m_pFirstFree;
+		m_pFirstFree = m_pFirstFree->m_pNext;
+		if(++m_Live > m_Peak)
+			m_Peak = m_Live;
+		mem_zero(p, m_ObjectSize);
+		return p;
+	}
+
+	void Free(void *p)
+	{
+		if(!p)
+			return;
+
+		CFreeSlot *pSlot = (CFreeSlot *)p;
+		pSlot->m_pNext = m_pFirstFree;
+		m_pFirstFree = pSlot;
+		m_Live--;
+	}
+
+	const char *Name() const { return m_pName; }
+	int Live() const { return m_Live; }
+	int Peak() const { return m_Peak; }
+	int Capacity() const { return (int)m_apSlabs.size() * m_SlabSize; }
+
+	static CAllocPool *First() { return FirstPool(); }
+	CAllocPool *Next() const { return m_pNextPool; }
+};
+
+#define MACRO_ALLOC_POOL() \
+	public: \
+	void *operator new(size_t Size); \
+	void operator delete(void *p); \
+	private:
+
+#define MACRO_ALLOC_POOL_IMPL(POOLTYPE, SlabSize) \
+	static CAllocPool ms_Pool##POOLTYPE(#POOLTYPE, sizeof(POOLTYPE), SlabSize); \
+	void *POOLTYPE::operator new(size_t Size) \
+	{ \
+		dbg_assert(sizeof(POOLTYPE) == Size, "size error"); \
+		return ms_Pool##POOLTYPE.Alloc(); \
+	} \
+	void POOLTYPE::operator delete(void *p) \
+	{ \
+		ms_Pool##POOLTYPE.Free(p); \
+	}
+
 #endif
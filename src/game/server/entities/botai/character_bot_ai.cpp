@@ -72,7 +72,7 @@ void CCharacterBotAI::GiveRandomEffects(int To)
 		{
 			int MobID = m_pBotPlayer->GetBotMobID();
 			if(const CMobBuffDebuff* pBuff = MobBotInfo::ms_aMobBot[MobID].GetRandomEffect())
-				pPlayerTo->GiveEffect(pBuff->getEffect(), pBuff->getTime(), pBuff->getChance());
+				pPlayerTo->GiveEffect(pBuff->getEffectID(), pBuff->getTime(), pBuff->getChance());
 		}
 	}
 }
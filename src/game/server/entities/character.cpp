@@ -77,6 +77,7 @@ bool CCharacter::Spawn(CPlayer *pPlayer, vec2 Pos)
 	if(!m_pPlayer->IsBot())
 	{
 		m_pPlayer->m_MoodState = m_pPlayer->GetMoodState();
+		m_pPlayer->InvalidateAttributes();
 
 		GS()->Mmo()->Quest()->UpdateArrowStep(m_pPlayer);
 		GS()->Mmo()->Quest()->AcceptNextStoryQuestStep(m_pPlayer);
@@ -860,7 +861,7 @@ bool CCharacter::TakeDamage(vec2 Force, int Dmg, int FromCID, int Weapon)
 		std::for_each(PotionTools::Heal::getList().begin(), PotionTools::Heal::getList().end(), [this](const PotionTools::Heal& p)
 		{
 			CPlayerItem* pPlayerItem = m_pPlayer->GetItem(p.getItemID());
-			if(!m_pPlayer->IsActiveEffect(p.getEffect()) && pPlayerItem->IsEquipped())
+			if(!m_pPlayer->IsActiveEffect(p.getEffectID()) && pPlayerItem->IsEquipped())
 				pPlayerItem->Use(1);
 		});
 	}
@@ -1118,7 +1119,7 @@ void CCharacter::HandleIndependentTuning()
 
 void CCharacter::HandleBuff(CTuningParams* TuningParams)
 {
-	if(m_pPlayer->IsActiveEffect("Slowdown"))
+	if(m_pPlayer->IsActiveEffect(EFFECT_SLOWDOWN))
 	{
 		TuningParams->m_Gravity = 0.35f;
 		TuningParams->m_GroundFriction = 0.45f;
@@ -1135,18 +1136,18 @@ void CCharacter::HandleBuff(CTuningParams* TuningParams)
 	// poisons
 	if(Server()->Tick() % Server()->TickSpeed() == 0)
 	{
-		if(m_pPlayer->IsActiveEffect("Fire"))
+		if(m_pPlayer->IsActiveEffect(EFFECT_FIRE))
 		{
 			const int ExplodeDamageSize = translate_to_percent_rest(m_pPlayer->GetStartHealth(), 3);
 			GS()->CreateExplosion(m_Core.m_Pos, m_pPlayer->GetCID(), WEAPON_GRENADE, 0);
 			TakeDamage(vec2(0, 0), ExplodeDamageSize, m_pPlayer->GetCID(), WEAPON_SELF);
 		}
-		if(m_pPlayer->IsActiveEffect("Poison"))
+		if(m_pPlayer->IsActiveEffect(EFFECT_POISON))
 		{
 			const int PoisonSize = translate_to_percent_rest(m_pPlayer->GetStartHealth(), 3);
 			TakeDamage(vec2(0, 0), PoisonSize, m_pPlayer->GetCID(), WEAPON_SELF);
 		}
-		if(m_pPlayer->IsActiveEffect("RegenMana"))
+		if(m_pPlayer->IsActiveEffect(EFFECT_REGEN_MANA))
 		{
 			const int RestoreMana = translate_to_percent_rest(m_pPlayer->GetStartMana(), 5);
 			IncreaseMana(RestoreMana);
@@ -1155,7 +1156,7 @@ void CCharacter::HandleBuff(CTuningParams* TuningParams)
 		// worker health potions
 		std::for_each(PotionTools::Heal::getList().begin(), PotionTools::Heal::getList().end(), [this](const PotionTools::Heal& p)
 		{
-			if(m_pPlayer->IsActiveEffect(p.getEffect()))
+			if(m_pPlayer->IsActiveEffect(p.getEffectID()))
 				IncreaseHealth(p.getRecovery());
 		});
 	}
@@ -1299,7 +1300,7 @@ bool CCharacter::CheckFailMana(int Mana)
 	}
 
 	m_Mana -= Mana;
-	if(m_Mana <= m_pPlayer->GetStartMana() / 5 && !m_pPlayer->IsActiveEffect("RegenMana") && m_pPlayer->GetItem(itPotionManaRegen)->IsEquipped())
+	if(m_Mana <= m_pPlayer->GetStartMana() / 5 && !m_pPlayer->IsActiveEffect(EFFECT_REGEN_MANA) && m_pPlayer->GetItem(itPotionManaRegen)->IsEquipped())
 		m_pPlayer->GetItem(itPotionManaRegen)->Use(1);
 
 	m_pPlayer->ShowInformationStats();
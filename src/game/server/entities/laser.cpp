@@ -6,6 +6,8 @@
 #include <generated/server_data.h>
 #include "character.h"
 
+MACRO_ALLOC_POOL_IMPL(CLaser, 64)
+
 CLaser::CLaser(CGameWorld *pGameWorld, vec2 Pos, vec2 Direction, float StartEnergy, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_LASER, Pos)
 {
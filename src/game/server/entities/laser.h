@@ -6,6 +6,8 @@
 
 class CLaser : public CEntity
 {
+	MACRO_ALLOC_POOL()
+
 public:
 	CLaser(CGameWorld *pGameWorld, vec2 Pos, vec2 Direction, float StartEnergy, int Owner);
 
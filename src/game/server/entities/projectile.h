@@ -6,6 +6,8 @@
 
 class CProjectile : public CEntity
 {
+	MACRO_ALLOC_POOL()
+
 	vec2 m_Direction;
 	int m_LifeSpan;
 	int m_Owner;
@@ -9,6 +9,9 @@ CEntity::CEntity(CGameWorld *pGameWorld, int ObjType, vec2 Pos, int ProximityRad
 
 	m_pPrevTypeEntity = nullptr;
 	m_pNextTypeEntity = nullptr;
+	m_pPrevScheduled = nullptr;
+	m_pNextScheduled = nullptr;
+	m_WakeTick = 0;
 
 	m_ID = Server()->SnapNewID();
 	m_ObjType = ObjType;
@@ -54,3 +57,24 @@ bool CEntity::GameLayerClipped(vec2 CheckPos) const
 	return (rx < -200 || rx >= GS()->Collision()->GetWidth()+200)
 			|| (ry < -200 || ry >= GS()->Collision()->GetHeight()+200);
 }
+
+void CSleepingBox::Move(const CCollision* pCollision, vec2* pPos, vec2* pVel, float Size, float Elasticity)
+{
+	if(IsSleeping())
+		return;
+
+	const vec2 OldPos = *pPos;
+	pCollision->MovePhysicalBox(pPos, pVel, vec2(Size, Size), Elasticity);
+
+	// resting on the ground, the bouncing is below a pixel
+	const float HalfSize = Size / 2.0f;
+	const bool Grounded = pCollision->CheckPoint(pPos->x - HalfSize, pPos->y + HalfSize + 5) || pCollision->CheckPoint(pPos->x + HalfSize, pPos->y + HalfSize + 5);
+	if(!Grounded || distance(OldPos, *pPos) > 0.5f || absolute(pVel->x) > 0.5f)
+	{
+		m_RestTicks = 0;
+		return;
+	}
+
+	if(++m_RestTicks >= SLEEP_AFTER_TICKS)
+		*pVel = vec2(0.0f, 0.0f);
+}
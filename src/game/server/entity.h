@@ -24,6 +24,11 @@ private:
 	CEntity *m_pPrevTypeEntity;
 	CEntity *m_pNextTypeEntity;
 
+	/* Scheduling, either in the active list of the type or in a timer wheel slot */
+	CEntity *m_pPrevScheduled;
+	CEntity *m_pNextScheduled;
+	int m_WakeTick; // 0 = awake, -1 = until woken up
+
 	int m_ID;
 	int m_ObjType;
 
@@ -69,9 +74,20 @@ public:
 	float GetProximityRadius() const	{ return m_ProximityRadius; }
 	bool IsMarkedForDestroy() const		{ return m_MarkedForDestroy; }
 
+	bool IsSleeping() const				{ return m_WakeTick != 0; }
+
 	/* Setters */
 	void MarkForDestroy()				{ m_MarkedForDestroy = true; }
 
+	/*
+		Function: Sleep, SleepUntil, Wake
+			Sleeping entities are not ticked (but still snapped)
+			until the given server tick or until woken up.
+	*/
+	void Sleep()						{ m_pGameWorld->ScheduleEntity(this, -1); }
+	void SleepUntil(int Tick)			{ m_pGameWorld->ScheduleEntity(this, Tick); }
+	void Wake()							{ m_pGameWorld->ScheduleEntity(this, 0); }
+
 	/* Other functions */
 
 	/*
@@ -173,4 +189,29 @@ public:
 	}
 };
 
+/*
+	Class: CSleepingBox
+		CEntityComponent. Moves a physical box until it lies still on
+		the ground, after that the box sleeps and is not moved anymore
+		until it's woken up. The map collision doesn't change at runtime,
+		so a lying box stays where it is.
+*/
+class CSleepingBox
+{
+	enum
+	{
+		SLEEP_AFTER_TICKS = 10,
+	};
+
+	int m_RestTicks;
+
+public:
+	CSleepingBox() : m_RestTicks(0) {}
+
+	bool IsSleeping() const { return m_RestTicks >= SLEEP_AFTER_TICKS; }
+	void Wake() { m_RestTicks = 0; }
+
+	void Move(const class CCollision* pCollision, vec2* pPos, vec2* pVel, float Size, float Elasticity);
+};
+
 #endif
@@ -2,9 +2,11 @@
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "gamecontext.h"
 
+#include <engine/engine.h>
 #include <engine/storage.h>
 #include <engine/map.h>
 #include <engine/shared/config.h>
+#include <engine/shared/profiler.h>
 
 #include <game/gamecore.h>
 #include <game/layers.h>
@@ -14,6 +16,7 @@
 
 #include "mmocore/CommandProcessor.h"
 #include "mmocore/PathFinder.h"
+#include "mmocore/Utils/IdAllocator.h"
 #include "mmocore/GameEntities/loltext.h"
 #include "mmocore/GameEntities/Items/drop_bonuses.h"
 #include "mmocore/GameEntities/Items/drop_items.h"
@@ -36,7 +39,20 @@
 #include "mmocore/Components/Worlds/WorldData.h"
 
 // static data that have the same value in different objects
-std::unordered_map < std::string, int > CGS::ms_aEffects[MAX_PLAYERS];
+CEffectTimers CGS::ms_aEffects[MAX_PLAYERS];
+CGS::CVoteTraffic CGS::ms_aVoteTraffic[MAX_PLAYERS];
+CJobPool CGS::ms_VoteJobPool;
+
+class CVoteMenuJob : public IJob
+{
+	CGS* m_pGS;
+	int m_ClientID;
+
+	void Run() override { m_pGS->RunVoteJob(m_ClientID); }
+
+public:
+	CVoteMenuJob(CGS* pGS, int ClientID) : m_pGS(pGS), m_ClientID(ClientID) {}
+};
 int CGS::m_MultiplierExp = 100;
 
 CGS::CGS()
@@ -53,6 +69,13 @@ CGS::CGS()
 	for(auto& apPlayer : m_apPlayers)
 		apPlayer = nullptr;
 
+	for(int i = 0; i < MAX_PLAYERS; i++)
+	{
+		m_aVoteRequest[i] = 0;
+		m_aVoteJobQueued[i] = false;
+	}
+	m_VoteJobsActive = 0;
+
 	m_pServer = nullptr;
 	m_pController = nullptr;
 	m_pMmoController = nullptr;
@@ -63,9 +86,15 @@ CGS::CGS()
 
 CGS::~CGS()
 {
+	// let queued menu jobs finish, they have nothing left to render
+	for(auto& Request : m_aVoteRequest)
+		Request = 0;
+	while(m_VoteJobsActive > 0)
+		thread_sleep(1);
+
 	m_Events.Clear();
 	for(auto& pEffects : ms_aEffects)
-		pEffects.clear();
+		pEffects.Clear();
 	for(auto* apPlayer : m_apPlayers)
 		delete apPlayer;
 
@@ -111,11 +140,26 @@ CPlayer* CGS::GetPlayerFromUserID(int AccountID)
 
 // Level String by Matodor (Progress Bar) creates some sort of bar progress
 std::unique_ptr<char[]> CGS::LevelString(int MaxValue, int CurrentValue, int Step, char toValue, char fromValue)
+{
+	const int Size = 3 + MaxValue / Step;
+	std::unique_ptr<char[]> Buf(new char[Size]);
+	LevelString(Buf.get(), Size, MaxValue, CurrentValue, Step, toValue, fromValue);
+	return Buf;
+}
+
+void CGS::LevelString(char* pBuffer, int BufferSize, int MaxValue, int CurrentValue, int Step, char toValue, char fromValue)
 {
 	CurrentValue = clamp(CurrentValue, 0, MaxValue);
 
 	const int Size = 3 + MaxValue / Step;
-	std::unique_ptr<char[]> Buf(new char[Size]);
+	if(BufferSize < Size)
+	{
+		if(BufferSize > 0)
+			pBuffer[0] = '\0';
+		return;
+	}
+
+	char* Buf = pBuffer;
 	Buf[0] = '[';
 	Buf[Size - 2] = ']';
 	Buf[Size - 1] = '\0';
@@ -128,8 +172,6 @@ std::unique_ptr<char[]> CGS::LevelString(int MaxValue, int CurrentValue, int Ste
 		Buf[i] = toValue;
 	for (int bi = 0; bi < b || i < Size - 2; bi++, i++)
 		Buf[i] = fromValue;
-
-	return Buf;
 }
 
 CItemDescription* CGS::GetItemInfo(ItemIdentifier ItemID) const
@@ -361,31 +403,60 @@ void CGS::FakeChat(const char *pName, const char *pText)
 	m_apPlayers[FakeClientID] = nullptr;
 }
 
-// send a formatted message
-void CGS::Chat(int ClientID, const char* pText, ...)
+int CGS::GroupByLanguage(int64 Mask, CLanguageGroup* pGroups) const
 {
-	const int Start = (ClientID < 0 ? 0 : ClientID);
-	const int End = (ClientID < 0 ? MAX_PLAYERS : ClientID + 1);
+	int NumGroups = 0;
+	for(int i = 0; i < MAX_PLAYERS; i++)
+	{
+		if(!(Mask & ((int64)1 << i)) || !m_apPlayers[i])
+			continue;
 
-	CNetMsg_Sv_Chat Msg;
-	Msg.m_Team = -1;
-	Msg.m_ClientID = -1;
+		CLocalization::CLanguage* pLanguage = m_apPlayers[i]->GetLanguageInfo();
+		int Group = 0;
+		while(Group < NumGroups && pGroups[Group].m_pLanguage != pLanguage)
+			Group++;
 
-	va_list VarArgs;
-	va_start(VarArgs, pText);
+		if(Group == NumGroups)
+			pGroups[NumGroups++] = { pLanguage, 0 };
+		pGroups[Group].m_Mask |= (int64)1 << i;
+	}
+	return NumGroups;
+}
+
+void CGS::ChatMasked(int64 Mask, const char* pPrefix, const char* pText, va_list VarArgs)
+{
+	CLanguageGroup aGroups[MAX_PLAYERS];
+	const int NumGroups = GroupByLanguage(Mask, aGroups);
 
 	dynamic_string Buffer;
-	for (int i = Start; i < End; i++)
+	for(int Group = 0; Group < NumGroups; Group++)
 	{
-		if (m_apPlayers[i])
-		{
-			Server()->Localization()->Format_VL(Buffer, m_apPlayers[i]->GetLanguage(), pText, VarArgs);
+		if(pPrefix)
+			Buffer.append(pPrefix);
+		Server()->Localization()->Format_VL(Buffer, aGroups[Group].m_pLanguage, pText, VarArgs);
 
-			Msg.m_pMessage = Buffer.buffer();
-			Server()->SendPackMsg(&Msg, MSGFLAG_VITAL, i);
-			Buffer.clear();
-		}
+		CNetMsg_Sv_Chat Msg;
+		Msg.m_Team = -1;
+		Msg.m_ClientID = -1;
+		Msg.m_pMessage = Buffer.buffer();
+
+		// one pack per group, the same chunk goes to every member
+		CMsgPacker Packer(Msg.MsgID(), false);
+		if(!Msg.Pack(&Packer))
+			Server()->SendMsgMasked(&Packer, MSGFLAG_VITAL, aGroups[Group].m_Mask);
+		Buffer.clear();
 	}
+}
+
+// send a formatted message
+void CGS::Chat(int ClientID, const char* pText, ...)
+{
+	if(ClientID >= MAX_PLAYERS)
+		return;
+
+	va_list VarArgs;
+	va_start(VarArgs, pText);
+	ChatMasked(ClientID < 0 ? -1 : (int64)1 << ClientID, nullptr, pText, VarArgs);
 	va_end(VarArgs);
 }
 
@@ -396,19 +467,9 @@ bool CGS::ChatAccount(int AccountID, const char* pText, ...)
 	if(!pPlayer)
 		return false;
 
-	CNetMsg_Sv_Chat Msg;
-	Msg.m_Team = -1;
-	Msg.m_ClientID = -1;
-
 	va_list VarArgs;
 	va_start(VarArgs, pText);
-
-	dynamic_string Buffer;
-	Server()->Localization()->Format_VL(Buffer, pPlayer->GetLanguage(), pText, VarArgs);
-
-	Msg.m_pMessage = Buffer.buffer();
-	Server()->SendPackMsg(&Msg, MSGFLAG_VITAL, pPlayer->GetCID());
-	Buffer.clear();
+	ChatMasked((int64)1 << pPlayer->GetCID(), nullptr, pText, VarArgs);
 	va_end(VarArgs);
 	return true;
 }
@@ -419,56 +480,34 @@ void CGS::ChatGuild(int GuildID, const char* pText, ...)
 	if(GuildID <= 0)
 		return;
 
-	CNetMsg_Sv_Chat Msg;
-	Msg.m_Team = -1;
-	Msg.m_ClientID = -1;
-
-	va_list VarArgs;
-	va_start(VarArgs, pText);
-
-	dynamic_string Buffer;
+	int64 Mask = 0;
 	for(int i = 0 ; i < MAX_PLAYERS ; i ++)
 	{
 		CPlayer *pPlayer = GetPlayer(i, true);
 		if(pPlayer && pPlayer->Acc().IsGuild() && pPlayer->Acc().m_GuildID == GuildID)
-		{
-			Buffer.append("[Guild]");
-			Server()->Localization()->Format_VL(Buffer, m_apPlayers[i]->GetLanguage(), pText, VarArgs);
-
-			Msg.m_pMessage = Buffer.buffer();
-
-			Server()->SendPackMsg(&Msg, MSGFLAG_VITAL, i);
-			Buffer.clear();
-		}
+			Mask |= (int64)1 << i;
 	}
+
+	va_list VarArgs;
+	va_start(VarArgs, pText);
+	ChatMasked(Mask, "[Guild]", pText, VarArgs);
 	va_end(VarArgs);
 }
 
 // Send a message in world
 void CGS::ChatWorldID(int WorldID, const char* Suffix, const char* pText, ...)
 {
-	CNetMsg_Sv_Chat Msg;
-	Msg.m_Team = -1;
-	Msg.m_ClientID = -1;
-
-	va_list VarArgs;
-	va_start(VarArgs, pText);
-
-	dynamic_string Buffer;
+	int64 Mask = 0;
 	for (int i = 0; i < MAX_PLAYERS; i++)
 	{
 		CPlayer* pPlayer = GetPlayer(i, true);
-		if(!pPlayer || !IsPlayerEqualWorld(i, WorldID))
-			continue;
-
-		Buffer.append(Suffix);
-		Server()->Localization()->Format_VL(Buffer, m_apPlayers[i]->GetLanguage(), pText, VarArgs);
-
-		Msg.m_pMessage = Buffer.buffer();
-
-		Server()->SendPackMsg(&Msg, MSGFLAG_VITAL, i, WorldID);
-		Buffer.clear();
+		if(pPlayer && IsPlayerEqualWorld(i, WorldID))
+			Mask |= (int64)1 << i;
 	}
+
+	va_list VarArgs;
+	va_start(VarArgs, pText);
+	ChatMasked(Mask, Suffix, pText, VarArgs);
 	va_end(VarArgs);
 }
 
@@ -518,7 +557,7 @@ void CGS::Motd(int ClientID, const char* Text, ...)
 	if(m_apPlayers[ClientID])
 	{
 		dynamic_string Buffer;
-		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguage(), Text, VarArgs);
+		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguageInfo(), Text, VarArgs);
 
 		Msg.m_pMessage = Buffer.buffer();
 
@@ -544,42 +583,49 @@ void CGS::AddBroadcast(int ClientID, const char* pText, BroadcastPriority Priori
 	m_aBroadcastStates[ClientID].m_TimedPriority = Priority;
 }
 
-// formatted broadcast
-void CGS::Broadcast(int ClientID, BroadcastPriority Priority, int LifeSpan, const char *pText, ...)
+void CGS::BroadcastMasked(int64 Mask, BroadcastPriority Priority, int LifeSpan, const char* pText, va_list VarArgs)
 {
-	const int Start = (ClientID < 0 ? 0 : ClientID);
-	const int End = (ClientID < 0 ? MAX_PLAYERS : ClientID+1);
+	CLanguageGroup aGroups[MAX_PLAYERS];
+	const int NumGroups = GroupByLanguage(Mask, aGroups);
 
-	va_list VarArgs;
-	va_start(VarArgs, pText);
-	for(int i = Start; i < End; i++)
+	dynamic_string Buffer;
+	for(int Group = 0; Group < NumGroups; Group++)
 	{
-		if(m_apPlayers[i])
+		Server()->Localization()->Format_VL(Buffer, aGroups[Group].m_pLanguage, pText, VarArgs);
+		for(int i = 0; i < MAX_PLAYERS; i++)
 		{
-			dynamic_string Buffer;
-			Server()->Localization()->Format_VL(Buffer, m_apPlayers[i]->GetLanguage(), pText, VarArgs);
-			AddBroadcast(i, Buffer.buffer(), Priority, LifeSpan);
-			Buffer.clear();
+			if(aGroups[Group].m_Mask & ((int64)1 << i))
+				AddBroadcast(i, Buffer.buffer(), Priority, LifeSpan);
 		}
+		Buffer.clear();
 	}
+}
+
+// formatted broadcast
+void CGS::Broadcast(int ClientID, BroadcastPriority Priority, int LifeSpan, const char *pText, ...)
+{
+	if(ClientID >= MAX_PLAYERS)
+		return;
+
+	va_list VarArgs;
+	va_start(VarArgs, pText);
+	BroadcastMasked(ClientID < 0 ? -1 : (int64)1 << ClientID, Priority, LifeSpan, pText, VarArgs);
 	va_end(VarArgs);
 }
 
 // formatted world broadcast
 void CGS::BroadcastWorldID(int WorldID, BroadcastPriority Priority, int LifeSpan, const char *pText, ...)
 {
-	va_list VarArgs;
-	va_start(VarArgs, pText);
+	int64 Mask = 0;
 	for(int i = 0; i < MAX_PLAYERS; i++)
 	{
 		if(m_apPlayers[i] && IsPlayerEqualWorld(i, WorldID))
-		{
-			dynamic_string Buffer;
-			Server()->Localization()->Format_VL(Buffer, m_apPlayers[i]->GetLanguage(), pText, VarArgs);
-			AddBroadcast(i, Buffer.buffer(), Priority, LifeSpan);
-			Buffer.clear();
-		}
+			Mask |= (int64)1 << i;
 	}
+
+	va_list VarArgs;
+	va_start(VarArgs, pText);
+	BroadcastMasked(Mask, Priority, LifeSpan, pText, VarArgs);
 	va_end(VarArgs);
 }
 
@@ -729,10 +775,20 @@ void CGS::OnInit(int WorldID)
 	m_pServer = Kernel()->RequestInterface<IServer>();
 	m_pConsole = Kernel()->RequestInterface<IConsole>();
 	m_pStorage = Kernel()->RequestInterface<IStorageEngine>();
+	if(WorldID == MAIN_WORLD_ID)
+		CIdAllocator::Init(Kernel()->RequestInterface<IEngine>()); // the id blocks are refilled on the engine jobs
 	m_World.SetGameServer(this);
 	m_Events.SetGameServer(this);
 	m_WorldID = WorldID;
 
+	char aBuf[64];
+	str_format(aBuf, sizeof(aBuf), "world%d.entities", WorldID);
+	m_ProfilerEntities = Server()->Profiler()->RegisterSection(aBuf);
+	str_format(aBuf, sizeof(aBuf), "world%d.players", WorldID);
+	m_ProfilerPlayers = Server()->Profiler()->RegisterSection(aBuf);
+	str_format(aBuf, sizeof(aBuf), "world%d.mmo", WorldID);
+	m_ProfilerMmo = Server()->Profiler()->RegisterSection(aBuf);
+
 	for(int i = 0; i < NUM_NETOBJTYPES; i++)
 		Server()->SnapSetStaticsize(i, m_NetObjHandler.GetObjSize(i));
 
@@ -790,27 +846,36 @@ void CGS::OnConsoleInit()
 	Console()->Register("say", "r[text]", CFGFLAG_SERVER, ConSay, m_pServer, "Say in chat");
 	Console()->Register("addcharacter", "i[cid]r[botname]", CFGFLAG_SERVER, ConAddCharacter, m_pServer, "(Warning) Add new bot on database or update if finding <clientid> <bot name>");
 	Console()->Register("sync_lines_for_translate", "", CFGFLAG_SERVER, ConSyncLinesForTranslate, m_pServer, "Perform sync lines in translated files. Order non updated translated to up");
+	Console()->Register("vote_traffic", "", CFGFLAG_SERVER, ConVoteTraffic, m_pServer, "Show the vote menu messages sent to each client");
+	Console()->Register("entity_pools", "", CFGFLAG_SERVER, ConEntityPools, m_pServer, "Show the live and peak objects of the entity pools");
 }
 
 void CGS::OnTick()
 {
 	m_World.m_Core.m_Tuning = m_Tuning;
-	m_World.Tick();
-	m_pController->Tick();
-
-	for(int i = 0; i < MAX_CLIENTS; i++)
 	{
-		if(!Server()->ClientIngame(i) || !m_apPlayers[i] || m_apPlayers[i]->GetPlayerWorldID() != m_WorldID)
-			continue;
+		CProfileScope Scope(Server()->Profiler(), m_ProfilerEntities);
+		m_World.Tick();
+		m_pController->Tick();
+	}
 
-		m_apPlayers[i]->Tick();
-		m_apPlayers[i]->PostTick();
-		if(i < MAX_PLAYERS)
+	{
+		CProfileScope Scope(Server()->Profiler(), m_ProfilerPlayers);
+		for(int i = 0; i < MAX_CLIENTS; i++)
 		{
-			BroadcastTick(i);
+			if(!Server()->ClientIngame(i) || !m_apPlayers[i] || m_apPlayers[i]->GetPlayerWorldID() != m_WorldID)
+				continue;
+
+			m_apPlayers[i]->Tick();
+			m_apPlayers[i]->PostTick();
+			if(i < MAX_PLAYERS)
+			{
+				BroadcastTick(i);
+			}
 		}
 	}
 
+	CProfileScope Scope(Server()->Profiler(), m_ProfilerMmo);
 	Mmo()->OnTick();
 }
 
@@ -1263,8 +1328,12 @@ const char *CGS::NetVersion() const { return GAME_NETVERSION; }
 void CGS::ClearClientData(int ClientID)
 {
 	Mmo()->ResetClientData(ClientID);
-	m_aPlayerVotes[ClientID]->clear();
-	ms_aEffects[ClientID].clear();
+	// every world keeps its own vote lists, the client may have had menus open in any of them
+	for(int i = 0; i < Server()->GetWorldsSize(); i++)
+		((CGS*)Server()->GameServer(i))->ResetVoteLists(ClientID);
+	m_aVoteRequest[ClientID] = 0;
+	ms_aVoteTraffic[ClientID] = {};
+	ms_aEffects[ClientID].Clear();
 
 	// clear active snap bots for player
 	for(auto& pActiveSnap : DataBotInfo::ms_aDataBot)
@@ -1400,13 +1469,109 @@ void CGS::ConchainGameinfoUpdate(IConsole::IResult *pResult, void *pUserData, IC
 /* #########################################################################
 	VOTING MMO GAMECONTEXT
 ######################################################################### */
+void CGS::ResetVoteLists(int ClientID)
+{
+	auto& pVotes = m_aPlayerVotes[ClientID];
+	std::lock_guard<safe_ptr<std::deque<CVoteOptions>>> Lock(pVotes);
+	pVotes->clear();
+	m_aPlayerVotesSent[ClientID].clear();
+}
+
 void CGS::ClearVotes(int ClientID)
 {
-	m_aPlayerVotes[ClientID]->clear();
+	ResetVoteLists(ClientID);
 
 	// send vote options
 	CNetMsg_Sv_VoteClearOptions ClearMsg;
-	Server()->SendPackMsg(&ClearMsg, MSGFLAG_VITAL, ClientID);
+	SendVoteMsg(ClientID, &ClearMsg);
+}
+
+template < class T >
+void CGS::SendVoteMsg(int ClientID, const T* pMsg)
+{
+	CMsgPacker Packer(pMsg->MsgID(), false);
+	if(pMsg->Pack(&Packer))
+		return;
+
+	Server()->SendMsg(&Packer, MSGFLAG_VITAL, ClientID);
+	ms_aVoteTraffic[ClientID].m_Messages++;
+	ms_aVoteTraffic[ClientID].m_Bytes += Packer.Size();
+}
+
+// send the difference between the built votes and what the client has
+void CGS::SendVotes(int ClientID)
+{
+	auto& pVotes = m_aPlayerVotes[ClientID];
+	std::lock_guard<safe_ptr<std::deque<CVoteOptions>>> Lock(pVotes);
+	const size_t NumVotes = pVotes->size();
+	std::vector<std::string>& aSent = m_aPlayerVotesSent[ClientID];
+
+	// options can only be appended on the client, so only the common beginning can stay
+	size_t Keep = 0;
+	while(Keep < aSent.size() && Keep < NumVotes && aSent[Keep] == (*pVotes)[Keep].m_aDescription)
+		Keep++;
+
+	// the client removes the first option with the description, it must not be one of the kept ones
+	bool FullUpdate = (aSent.size() - Keep) + (NumVotes - Keep) > NumVotes;
+	for(size_t i = Keep; i < aSent.size() && !FullUpdate; i++)
+		FullUpdate = std::find(aSent.begin(), aSent.begin() + Keep, aSent[i]) != aSent.begin() + Keep;
+
+	if(FullUpdate)
+	{
+		Keep = 0;
+		aSent.clear();
+		CNetMsg_Sv_VoteClearOptions ClearMsg;
+		SendVoteMsg(ClientID, &ClearMsg);
+	}
+	else
+	{
+		for(size_t i = Keep; i < aSent.size(); i++)
+		{
+			CNetMsg_Sv_VoteOptionRemove RemoveMsg;
+			RemoveMsg.m_pDescription = aSent[i].c_str();
+			SendVoteMsg(ClientID, &RemoveMsg);
+		}
+		aSent.resize(Keep);
+	}
+
+	ms_aVoteTraffic[ClientID].m_Skipped += Keep;
+	for(size_t i = Keep; i < NumVotes; i++)
+	{
+		CNetMsg_Sv_VoteOptionAdd OptionMsg;
+		OptionMsg.m_pDescription = (*pVotes)[i].m_aDescription;
+		SendVoteMsg(ClientID, &OptionMsg);
+		aSent.emplace_back(OptionMsg.m_pDescription);
+	}
+}
+
+void CGS::ConVoteTraffic(IConsole::IResult* pResult, void* pUserData)
+{
+	IServer* pServer = (IServer*)pUserData;
+	CGS* pSelf = (CGS*)pServer->GameServer(MAIN_WORLD_ID);
+
+	char aBuf[256];
+	for(int i = 0; i < MAX_PLAYERS; i++)
+	{
+		const CVoteTraffic& Traffic = ms_aVoteTraffic[i];
+		if(!pServer->ClientIngame(i) || !Traffic.m_Messages)
+			continue;
+
+		str_format(aBuf, sizeof(aBuf), "id=%d name='%s' messages=%lld bytes=%lld kept=%lld", i, pServer->ClientName(i), (long long)Traffic.m_Messages, (long long)Traffic.m_Bytes, (long long)Traffic.m_Skipped);
+		pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "votes", aBuf);
+	}
+}
+
+void CGS::ConEntityPools(IConsole::IResult* pResult, void* pUserData)
+{
+	IServer* pServer = (IServer*)pUserData;
+	CGS* pSelf = (CGS*)pServer->GameServer(MAIN_WORLD_ID);
+
+	char aBuf[256];
+	for(const CAllocPool* pPool = CAllocPool::First(); pPool; pPool = pPool->Next())
+	{
+		str_format(aBuf, sizeof(aBuf), "%s live=%d peak=%d capacity=%d", pPool->Name(), pPool->Live(), pPool->Peak(), pPool->Capacity());
+		pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "entities", aBuf);
+	}
 }
 
 // add a vote
@@ -1443,7 +1608,7 @@ void CGS::AVL(int ClientID, const char *pCmd, const char *pText, ...)
 		if(str_comp(pCmd, "null") != 0)
 			Buffer.append("- ");
 
-		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguage(), pText, VarArgs);
+		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguageInfo(), pText, VarArgs);
 		AV(ClientID, pCmd, Buffer.buffer());
 		Buffer.clear();
 
@@ -1466,7 +1631,7 @@ void CGS::AVH(int ClientID, const int HiddenID, const char *pText, ...)
 		dynamic_string Buffer;
 
 		Buffer.append(pSymbols);
-		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguage(), pText, VarArgs);
+		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguageInfo(), pText, VarArgs);
 		if(HiddenID > TAB_SETTINGS_MODULES && HiddenID < NUM_TAB_MENU) { Buffer.append(" (Press me for help)"); }
 
 		AV(ClientID, "HIDDEN", Buffer.buffer(), HiddenID, -1);
@@ -1491,7 +1656,7 @@ void CGS::AVM(int ClientID, const char *pCmd, const int TempInt, const int Hidde
 		dynamic_string Buffer;
 		if(TempInt != NOPE) { Buffer.append("- "); }
 
-		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguage(), pText, VarArgs);
+		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguageInfo(), pText, VarArgs);
 		AV(ClientID, pCmd, Buffer.buffer(), TempInt);
 		Buffer.clear();
 		va_end(VarArgs);
@@ -1513,7 +1678,7 @@ void CGS::AVD(int ClientID, const char *pCmd, const int TempInt, const int TempI
 		dynamic_string Buffer;
 		if(TempInt != NOPE) { Buffer.append("- "); }
 
-		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguage(), pText, VarArgs);
+		Server()->Localization()->Format_VL(Buffer, m_apPlayers[ClientID]->GetLanguageInfo(), pText, VarArgs);
 		AV(ClientID, pCmd, Buffer.buffer(), TempInt, TempInt2);
 		Buffer.clear();
 		va_end(VarArgs);
@@ -1527,18 +1692,44 @@ void CGS::StartCustomVotes(int ClientID, int LastVoteMenu)
 	{
 		pPlayer->m_OpenVoteMenu = CUSTOM_MENU;
 		pPlayer->m_LastVoteMenu = LastVoteMenu;
-		ClearVotes(ClientID);
+		m_aPlayerVotes[ClientID]->clear();
 	}
 }
 
 void CGS::EndCustomVotes(int ClientID)
 {
-	std::thread(&CallbackUpdateVotes, this, ClientID, CUSTOM_MENU, true).detach();
+	RequestVotes(ClientID, CUSTOM_MENU, true);
+}
+
+void CGS::RequestVotes(int ClientID, int Menulist, bool PrepareCustom)
+{
+	if(ClientID < 0 || ClientID >= MAX_PLAYERS)
+		return;
+
+	static std::once_flag s_InitPool;
+	std::call_once(s_InitPool, []() { ms_VoteJobPool.Init(g_Config.m_SvVoteMenuThreads); });
+
+	// a newer request replaces one that is still waiting
+	m_aVoteRequest[ClientID] = (Menulist - CUSTOM_MENU) * 2 + (PrepareCustom ? 1 : 0) + 1;
+	if(!m_aVoteJobQueued[ClientID].exchange(true))
+	{
+		m_VoteJobsActive++;
+		ms_VoteJobPool.Add(std::make_shared<CVoteMenuJob>(this, ClientID));
+	}
+}
+
+void CGS::RunVoteJob(int ClientID)
+{
+	// clear the flag first, a request arriving after the exchange queues a new job
+	m_aVoteJobQueued[ClientID] = false;
+	const int Request = m_aVoteRequest[ClientID].exchange(0);
+	if(Request)
+		CallbackUpdateVotes(this, ClientID, (Request - 1) / 2 + CUSTOM_MENU, (Request - 1) % 2);
+	m_VoteJobsActive--;
 }
 
 void CGS::CallbackUpdateVotes(CGS* pGS, int ClientID, int Menulist, bool PrepareCustom)
 {
-	std::this_thread::sleep_for(std::chrono::milliseconds(10));
 	std::unique_lock guard(pGS->m_mtxUniqueVotes);
 
 	CPlayer* pPlayer = pGS->GetPlayer(ClientID, true);
@@ -1548,33 +1739,22 @@ void CGS::CallbackUpdateVotes(CGS* pGS, int ClientID, int Menulist, bool Prepare
 	if(Menulist == CUSTOM_MENU && PrepareCustom)
 	{
 		// send parsed votes
-		for(auto p = pGS->m_aPlayerVotes[ClientID]->begin(); p != pGS->m_aPlayerVotes[ClientID]->end(); ++p)
-		{
-			CNetMsg_Sv_VoteOptionAdd OptionMsg;
-			OptionMsg.m_pDescription = p->m_aDescription;
-			pGS->Server()->SendPackMsg(&OptionMsg, MSGFLAG_VITAL, ClientID);
-		}
+		pGS->SendVotes(ClientID);
 		return;
 	}
 
 	// parse votes
 	pPlayer->m_OpenVoteMenu = Menulist;
-	pGS->ClearVotes(ClientID);
+	pGS->m_aPlayerVotes[ClientID]->clear();
 	pGS->Mmo()->OnPlayerHandleMainMenu(ClientID, Menulist);
 
 	// send parsed votes
-	for(auto p = pGS->m_aPlayerVotes[ClientID]->begin(); p != pGS->m_aPlayerVotes[ClientID]->end(); ++p)
-	{
-		CNetMsg_Sv_VoteOptionAdd OptionMsg;
-		OptionMsg.m_pDescription = p->m_aDescription;
-		pGS->Server()->SendPackMsg(&OptionMsg, MSGFLAG_VITAL, ClientID);
-	}
+	pGS->SendVotes(ClientID);
 }
 
 void CGS::UpdateVotes(int ClientID, int MenuList)
 {
-	// unfully safe
-	std::thread(&CallbackUpdateVotes, this, ClientID, MenuList, false).detach();
+	RequestVotes(ClientID, MenuList, false);
 }
 
 // information for unauthorized players
@@ -1741,8 +1921,7 @@ void CGS::CreateText(CEntity* pParent, bool Follow, vec2 Pos, vec2 Vel, int Life
 	if(!IsPlayersNearby(Pos, 800))
 		return;
 
-	CLoltext Text;
-	Text.Create(&m_World, pParent, Pos, Vel, Lifespan, pText, true, Follow);
+	CLoltext::Create(&m_World, pParent, Pos, Vel, Lifespan, pText, true, Follow);
 }
 
 // creates a particle of experience that follows the player
@@ -5,6 +5,7 @@
 
 #include <engine/console.h>
 #include <engine/server.h>
+#include <engine/shared/jobs.h>
 
 #include <game/collision.h>
 #include <game/voting.h>
@@ -40,6 +41,10 @@ class CGS : public IGameServer
 	int m_DungeonID;
 	int m_RespawnWorldID;
 
+	int m_ProfilerEntities;
+	int m_ProfilerPlayers;
+	int m_ProfilerMmo;
+
 public:
 	IServer *Server() const { return m_pServer; }
 	IConsole* Console() const { return m_pConsole; }
@@ -62,7 +67,7 @@ public:
 	/* #########################################################################
 		SWAP GAMECONTEX DATA
 	######################################################################### */
-	static std::unordered_map < std::string /* effect */, int /* seconds */ > ms_aEffects[MAX_PLAYERS];
+	static CEffectTimers ms_aEffects[MAX_PLAYERS];
 	// - - - - - - - - - - - -
 
 	/* #########################################################################
@@ -72,6 +77,7 @@ public:
 	CPlayer *GetPlayer(int ClientID, bool CheckAuthed = false, bool CheckCharacter = false);
 	CPlayer *GetPlayerFromUserID(int AccountID);
 	std::unique_ptr<char[]> LevelString(int MaxValue, int CurrentValue, int Step, char toValue, char fromValue);
+	void LevelString(char* pBuffer, int BufferSize, int MaxValue, int CurrentValue, int Step, char toValue, char fromValue);
 	class CItemDescription* GetItemInfo(ItemIdentifier ItemID) const;
 	CQuestDataInfo &GetQuestInfo(int QuestID) const;
 	class CAttributeDescription* GetAttributeInfo(AttributeIdentifier ID) const;
@@ -96,6 +102,16 @@ private:
 	void SendChat(int ChatterClientID, int Mode, const char *pText);
 	void UpdateDiscordStatus();
 
+	// recipients with the same language share one formatted and packed message
+	struct CLanguageGroup
+	{
+		CLocalization::CLanguage* m_pLanguage;
+		int64 m_Mask;
+	};
+	int GroupByLanguage(int64 Mask, CLanguageGroup* pGroups) const;
+	void ChatMasked(int64 Mask, const char* pPrefix, const char* pText, va_list VarArgs);
+	void BroadcastMasked(int64 Mask, BroadcastPriority Priority, int LifeSpan, const char* pText, va_list VarArgs);
+
 public:
 	void FakeChat(const char *pName, const char *pText) override;
 	void Chat(int ClientID, const char* pText, ...);
@@ -190,8 +206,28 @@ private:
 	######################################################################### */
 	std::mutex m_mtxUniqueVotes;
 	safe_ptr< std::deque<CVoteOptions> > m_aPlayerVotes[MAX_PLAYERS];
+	std::vector< std::string > m_aPlayerVotesSent[MAX_PLAYERS]; // descriptions the client currently has, guarded by the m_aPlayerVotes lock
 	static void CallbackUpdateVotes(CGS* pGS, int ClientID, int Menulist, bool PrepareCustom);
 
+	// menus are rendered on a shared pool, a client has at most one queued job and it renders the latest request
+	friend class CVoteMenuJob;
+	static CJobPool ms_VoteJobPool;
+	std::atomic<int> m_aVoteRequest[MAX_PLAYERS]; // 0 when nothing is requested
+	std::atomic<bool> m_aVoteJobQueued[MAX_PLAYERS];
+	std::atomic<int> m_VoteJobsActive;
+	void RequestVotes(int ClientID, int Menulist, bool PrepareCustom);
+	void RunVoteJob(int ClientID);
+
+	struct CVoteTraffic
+	{
+		int64 m_Messages;
+		int64 m_Bytes;
+		int64 m_Skipped; // options that were already on the client
+	};
+	static CVoteTraffic ms_aVoteTraffic[MAX_PLAYERS];
+	static void ConVoteTraffic(IConsole::IResult* pResult, void* pUserData);
+	static void ConEntityPools(IConsole::IResult* pResult, void* pUserData);
+
 public:
 	void AV(int ClientID , const char *pCmd, const char *pDesc = "\0", int TempInt = -1, int TempInt2 = -1);
 	void AVL(int ClientID, const char *pCmd, const char *pText, ...);
@@ -200,7 +236,11 @@ public:
 	void AVD(int ClientID, const char *pCmd, int TempInt, int TempInt2, int HiddenID, const char *pText, ...);
 
 private:
+	void ResetVoteLists(int ClientID);
 	void ClearVotes(int ClientID);
+	void SendVotes(int ClientID);
+	template < class T >
+	void SendVoteMsg(int ClientID, const T* pMsg);
 	void ShowVotesNewbieInformation(int ClientID);
 
 public:
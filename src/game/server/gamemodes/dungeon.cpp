@@ -158,6 +158,18 @@ void CGameControllerDungeon::ChangeState(int State)
 
 	// door state
 	m_DungeonDoor->SetState(State);
+
+	// the sync attributes depend on the state, the sync factor and the active players
+	InvalidatePlayersAttributes();
+}
+
+void CGameControllerDungeon::InvalidatePlayersAttributes()
+{
+	for(int i = 0; i < MAX_PLAYERS; i++)
+	{
+		if(GS()->m_apPlayers[i] && GS()->IsPlayerEqualWorld(i, m_WorldID))
+			GS()->m_apPlayers[i]->InvalidateAttributes();
+	}
 }
 
 void CGameControllerDungeon::StateTick()
@@ -311,7 +323,10 @@ bool CGameControllerDungeon::OnCharacterSpawn(CCharacter* pChr)
 
 			// update tanking client status
 			if(ClientID == m_TankClientID)
+			{
 				pChr->GetPlayer()->m_MoodState = Mood::TANK;
+				pChr->GetPlayer()->InvalidateAttributes();
+			}
 
 			// player died after the safety timer ended
 			if(!m_SafeTick)
@@ -59,6 +59,7 @@ private:
 	int CountMobs() const;
 
 	void ChangeState(int State);
+	void InvalidatePlayersAttributes();
 	void StateTick();
 	void SetMobsSpawn(bool AllowedSpawn);
 	void KillAllPlayers();
@@ -16,7 +16,15 @@ CGameWorld::CGameWorld(): m_pNextTraverseEntity(nullptr), m_Paused(false)
 
 	m_ResetRequested = false;
 	for (int i = 0; i < NUM_ENTTYPES; i++)
+	{
 		m_apFirstEntityTypes[i] = nullptr;
+		m_apFirstActiveTypes[i] = nullptr;
+	}
+
+	m_pNextTraverseActive = nullptr;
+	for(auto& pSlot : m_apWheel)
+		pSlot = nullptr;
+	m_WheelTick = -1;
 }
 
 CGameWorld::~CGameWorld()
@@ -71,6 +79,84 @@ void CGameWorld::InsertEntity(CEntity *pEnt)
 	pEnt->m_pNextTypeEntity = m_apFirstEntityTypes[pEnt->m_ObjType];
 	pEnt->m_pPrevTypeEntity = nullptr;
 	m_apFirstEntityTypes[pEnt->m_ObjType] = pEnt;
+
+	// new entities start awake
+	LinkSchedule(pEnt, 0);
+}
+
+void CGameWorld::LinkSchedule(CEntity *pEnt, int WakeTick)
+{
+	CEntity **ppFirst = nullptr;
+	if(WakeTick == 0)
+		ppFirst = &m_apFirstActiveTypes[pEnt->m_ObjType];
+	else if(WakeTick > 0)
+		ppFirst = &m_apWheel[WakeTick % WHEEL_SIZE];
+
+	pEnt->m_WakeTick = WakeTick;
+	pEnt->m_pPrevScheduled = nullptr;
+	pEnt->m_pNextScheduled = nullptr;
+	if(!ppFirst)
+		return;
+
+	if(*ppFirst)
+		(*ppFirst)->m_pPrevScheduled = pEnt;
+	pEnt->m_pNextScheduled = *ppFirst;
+	*ppFirst = pEnt;
+}
+
+void CGameWorld::UnlinkSchedule(CEntity *pEnt)
+{
+	if(pEnt->m_pPrevScheduled)
+		pEnt->m_pPrevScheduled->m_pNextScheduled = pEnt->m_pNextScheduled;
+	else if(pEnt->m_WakeTick == 0)
+		m_apFirstActiveTypes[pEnt->m_ObjType] = pEnt->m_pNextScheduled;
+	else if(pEnt->m_WakeTick > 0)
+		m_apWheel[pEnt->m_WakeTick % WHEEL_SIZE] = pEnt->m_pNextScheduled;
+	if(pEnt->m_pNextScheduled)
+		pEnt->m_pNextScheduled->m_pPrevScheduled = pEnt->m_pPrevScheduled;
+
+	// keep list traversing valid
+	if(m_pNextTraverseActive == pEnt)
+		m_pNextTraverseActive = pEnt->m_pNextScheduled;
+
+	pEnt->m_pPrevScheduled = nullptr;
+	pEnt->m_pNextScheduled = nullptr;
+}
+
+void CGameWorld::ScheduleEntity(CEntity *pEnt, int WakeTick)
+{
+	// not in the world
+	if(!pEnt->m_pNextTypeEntity && !pEnt->m_pPrevTypeEntity && m_apFirstEntityTypes[pEnt->m_ObjType] != pEnt)
+		return;
+
+	// the tick has passed already
+	if(WakeTick > 0 && WakeTick <= Server()->Tick())
+		WakeTick = 0;
+	if(WakeTick == pEnt->m_WakeTick)
+		return;
+
+	UnlinkSchedule(pEnt);
+	LinkSchedule(pEnt, WakeTick);
+}
+
+void CGameWorld::WakeScheduled(int Tick)
+{
+	// every slot up to the tick, in case the world wasn't ticked for a while
+	const int First = max(m_WheelTick + 1, Tick - (int)WHEEL_SIZE + 1);
+	m_WheelTick = Tick;
+	for(int i = First; i <= Tick; i++)
+	{
+		for(CEntity *pEnt = m_apWheel[i % WHEEL_SIZE]; pEnt; )
+		{
+			CEntity *pNext = pEnt->m_pNextScheduled;
+			if(pEnt->m_WakeTick <= Tick)
+			{
+				UnlinkSchedule(pEnt);
+				LinkSchedule(pEnt, 0);
+			}
+			pEnt = pNext;
+		}
+	}
 }
 
 void CGameWorld::DestroyEntity(CEntity *pEnt)
@@ -98,6 +184,9 @@ void CGameWorld::RemoveEntity(CEntity *pEnt)
 
 	pEnt->m_pNextTypeEntity = nullptr;
 	pEnt->m_pPrevTypeEntity = nullptr;
+
+	UnlinkSchedule(pEnt);
+	pEnt->m_WakeTick = 0;
 }
 
 //
@@ -164,22 +253,25 @@ void CGameWorld::Tick()
 	if(m_ResetRequested)
 		Reset();
 
-	// update all objects
+	WakeScheduled(Server()->Tick());
+
+	// update awake objects, an entity that goes to sleep in Tick() skips TickDeferred()
 	for(int i = 0; i < NUM_ENTTYPES; i++)
-		for(CEntity *pEnt = m_apFirstEntityTypes[i]; pEnt; )
+		for(CEntity *pEnt = m_apFirstActiveTypes[i]; pEnt; )
 		{
-			m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
+			m_pNextTraverseActive = pEnt->m_pNextScheduled;
 			pEnt->Tick();
-			pEnt = m_pNextTraverseEntity;
+			pEnt = m_pNextTraverseActive;
 		}
 
 	for(int i = 0; i < NUM_ENTTYPES; i++)
-		for(CEntity *pEnt = m_apFirstEntityTypes[i]; pEnt; )
+		for(CEntity *pEnt = m_apFirstActiveTypes[i]; pEnt; )
 		{
-			m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
+			m_pNextTraverseActive = pEnt->m_pNextScheduled;
 			pEnt->TickDeferred();
-			pEnt = m_pNextTraverseEntity;
+			pEnt = m_pNextTraverseActive;
 		}
+	m_pNextTraverseActive = nullptr;
 
 	RemoveEntities();
 
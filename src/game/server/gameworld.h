@@ -54,6 +54,12 @@ public:
 		NUM_ENTTYPES
 	};
 
+	enum
+	{
+		// ticks covered by the timer wheel, later wake ticks go around it again
+		WHEEL_SIZE = 256,
+	};
+
 private:
 	void Reset();
 	void RemoveEntities();
@@ -61,6 +67,16 @@ private:
 	CEntity *m_pNextTraverseEntity;
 	CEntity *m_apFirstEntityTypes[NUM_ENTTYPES];
 
+	// only the entities that are awake are ticked, the sleeping ones wait in the timer wheel
+	CEntity *m_pNextTraverseActive;
+	CEntity *m_apFirstActiveTypes[NUM_ENTTYPES];
+	CEntity *m_apWheel[WHEEL_SIZE];
+	int m_WheelTick;
+
+	void LinkSchedule(CEntity *pEnt, int WakeTick);
+	void UnlinkSchedule(CEntity *pEnt);
+	void WakeScheduled(int Tick);
+
 	class CGS *m_pGS;
 	class IServer *m_pServer;
 
@@ -164,6 +180,17 @@ public:
 	*/
 	void DestroyEntity(CEntity *pEntity);
 
+	/*
+		Function: ScheduleEntity
+			Changes when the entity is ticked next.
+
+		Arguments:
+			entity - Entity to schedule
+			wake_tick - Server tick to wake up at, 0 to tick it
+				every tick again or -1 to sleep until woken up
+	*/
+	void ScheduleEntity(CEntity *pEnt, int WakeTick);
+
 	/*
 		Function: snap
 			Calls snap on all the entities in the world to create
@@ -177,8 +204,8 @@ public:
 	void PostSnap();
 	/*
 		Function: tick
-			Calls tick on all the entities in the world to progress
-			the world to the next tick.
+			Calls tick on all the awake entities in the world to
+			progress the world to the next tick.
 
 	*/
 	void Tick();
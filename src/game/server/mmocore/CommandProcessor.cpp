@@ -236,8 +236,17 @@ void CCommandProcessor::ConChatGiveEffect(IConsole::IResult* pResult, void* pUse
 	CGS* pGS = (CGS*)pServer->GameServer(pServer->GetClientWorldID(ClientID));
 
 	CPlayer* pPlayer = pGS->m_apPlayers[ClientID];
-	if(pPlayer && pPlayer->IsAuthed())
-		pPlayer->GiveEffect(pResult->GetString(0), pResult->GetInteger(1));
+	if(!pPlayer || !pPlayer->IsAuthed())
+		return;
+
+	// only effects known from the items, mobs and quests, names typed in chat are never registered
+	const int EffectID = CEffectRegistry::Get().Find(pResult->GetString(0));
+	if(EffectID == EFFECT_NONE)
+	{
+		pGS->Chat(ClientID, "Unknown effect.");
+		return;
+	}
+	pPlayer->GiveEffect(EffectID, pResult->GetInteger(1));
 }
 
 void CCommandProcessor::ConChatUseItem(IConsole::IResult* pResult, void* pUser)
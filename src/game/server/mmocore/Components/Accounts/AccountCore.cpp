@@ -4,6 +4,7 @@
 
 #include <engine/shared/config.h>
 #include <game/server/gamecontext.h>
+#include <game/server/mmocore/Utils/IdAllocator.h>
 
 #include <game/server/mmocore/Components/Dungeons/DungeonCore.h>
 #include <game/server/mmocore/Components/Mails/MailBoxCore.h>
@@ -12,6 +13,26 @@
 
 #include <base/hash_ctxt.h>
 
+void CAccountCore::OnInit()
+{
+	CAccountData::ms_Nicknames.SetCapacity(g_Config.m_SvNicknameCacheSize);
+	CIdAllocator::Get(ID_ACCOUNTS).Prefetch();
+
+	// rankings are kept in memory and updated on save, only loaded once. loaded before the server
+	// accepts players, so a score updated at login is never overwritten by the startup data
+	ResultPtr pRes = Database->Execute<DB::SELECT>("ID, Level, Exp", "tw_accounts_data");
+	while(pRes->next())
+	{
+		const int AccountID = pRes->getInt("ID");
+		CAccountRankingData::ms_Level.Set(AccountID, CAccountRankingData::LevelScore(pRes->getInt("Level"), pRes->getInt("Exp")));
+	}
+	Job()->ShowLoadingProgress("Account rankings", CAccountRankingData::ms_Level.Num());
+
+	ResultPtr pResGold = Database->Execute<DB::SELECT>("UserID, Value", "tw_accounts_items", "WHERE ItemID = '%d'", (ItemIdentifier)itGold);
+	while(pResGold->next())
+		CAccountRankingData::ms_Gold.Set(pResGold->getInt("UserID"), pResGold->getInt("Value"));
+}
+
 int CAccountCore::GetHistoryLatestCorrectWorldID(CPlayer* pPlayer) const
 {
 	const auto pWorldIterator = std::find_if(pPlayer->Acc().m_aHistoryWorld.begin(), pPlayer->Acc().m_aHistoryWorld.end(), [=](int WorldID)
@@ -45,8 +66,12 @@ AccountCodeResult CAccountCore::RegisterAccount(int ClientID, const char *Login,
 		return AccountCodeResult::AOP_NICKNAME_ALREADY_EXIST;
 	}
 
-	ResultPtr pResID = Database->Execute<DB::SELECT>("ID", "tw_accounts", "ORDER BY ID DESC LIMIT 1");
-	const int InitID = pResID->next() ? pResID->getInt("ID")+1 : 1; // thread save ? hm need for table all time auto increment = 1; NEED FIX IT
+	const int InitID = CIdAllocator::Get(ID_ACCOUNTS).Allocate();
+	if(InitID <= 0)
+	{
+		GS()->Chat(ClientID, "Registration is not available right now, try again later.");
+		return AccountCodeResult::AOP_UNKNOWN;
+	}
 
 	const CSqlString<32> cClearLogin = CSqlString<32>(Login);
 	const CSqlString<32> cClearPass = CSqlString<32>(Password);
@@ -125,6 +150,7 @@ AccountCodeResult CAccountCore::LoginAccount(int ClientID, const char *Login, co
 			if(pAttribute->HasField())
 				pPlayer->Acc().m_aStats[ID] = pResAccount->getInt(pAttribute->GetFieldName());
 		}
+		pPlayer->InvalidateAttributes();
 
 		GS()->Chat(ClientID, "- - - - - - - [Successful login!] - - - - - - -");
 		GS()->Chat(ClientID, "Don't forget that cl_motd_time must be set!");
@@ -161,6 +187,8 @@ void CAccountCore::LoadAccount(CPlayer *pPlayer, bool FirstInitilize)
 	}
 
 	Job()->OnInitAccount(ClientID);
+	CAccountData::ms_Nicknames.SetOnline(pPlayer->Acc().m_UserID, Server()->ClientName(ClientID));
+	CAccountRankingData::ms_Level.Set(pPlayer->Acc().m_UserID, CAccountRankingData::LevelScore(pPlayer->Acc().m_Level, pPlayer->Acc().m_Exp));
 	const int Rank = GetRank(pPlayer->Acc().m_UserID);
 	GS()->Chat(-1, "{STR} logged to account. Rank #{INT}", Server()->ClientName(ClientID), Rank);
 #ifdef CONF_DISCORD
@@ -238,21 +266,13 @@ bool CAccountCore::ChangeNickname(int ClientID)
 
 	Database->Execute<DB::UPDATE>("tw_accounts_data", "Nick = '%s' WHERE ID = '%d'", cClearNick.cstr(), pPlayer->Acc().m_UserID);
 	Server()->SetClientName(ClientID, Server()->GetClientNameChangeRequest(ClientID));
+	CAccountData::ms_Nicknames.SetOnline(pPlayer->Acc().m_UserID, Server()->ClientName(ClientID));
 	return true;
 }
 
 int CAccountCore::GetRank(int AccountID)
 {
-	int Rank = 0;
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_accounts_data", "ORDER BY Level DESC, Exp DESC");
-	while(pRes->next())
-	{
-		Rank++;
-		const int ID = pRes->getInt("ID");
-		if(AccountID == ID)
-			return Rank;
-	}
-	return -1;
+	return CAccountRankingData::ms_Level.GetRank(AccountID);
 }
 
 bool CAccountCore::OnHandleMenulist(CPlayer* pPlayer, int Menulist, bool ReplaceMenu)
@@ -346,6 +366,11 @@ bool CAccountCore::OnHandleVoteCommands(CPlayer* pPlayer, const char* CMD, const
 
 void CAccountCore::OnResetClient(int ClientID)
 {
+	// the nickname stays cached as an offline one
+	const auto Iter = CAccountData::ms_aData.find(ClientID);
+	if(Iter != CAccountData::ms_aData.end() && Iter->second.m_UserID > 0)
+		CAccountData::ms_Nicknames.SetOffline(Iter->second.m_UserID);
+
 	CAccountTempData::ms_aPlayerTempData.erase(ClientID);
 	CAccountData::ms_aData.erase(ClientID);
 }
@@ -12,8 +12,13 @@ class CAccountCore : public MmoComponent
 	{
 		CAccountData::ms_aData.clear();
 		CAccountTempData::ms_aPlayerTempData.clear();
+		CAccountRankingData::ms_Level.Clear();
+		CAccountRankingData::ms_Gold.Clear();
+		CAccountData::ms_Nicknames.Clear();
 	};
 
+	void OnInit() override;
+
 	bool OnHandleVoteCommands(CPlayer* pPlayer, const char* CMD, int VoteID, int VoteID2, int Get, const char* GetText) override;
 	bool OnHandleMenulist(CPlayer* pPlayer, int Menulist, bool ReplaceMenu) override;
 	void OnResetClient(int ClientID) override;
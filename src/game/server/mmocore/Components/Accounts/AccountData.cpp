@@ -3,4 +3,8 @@
 #include "AccountData.h"
 
 std::map < int, CAccountData > CAccountData::ms_aData;
-std::map < int, CAccountTempData > CAccountTempData::ms_aPlayerTempData;
\ No newline at end of file
+CNicknameCache CAccountData::ms_Nicknames;
+std::map < int, CAccountTempData > CAccountTempData::ms_aPlayerTempData;
+
+CLeaderboard CAccountRankingData::ms_Level;
+CLeaderboard CAccountRankingData::ms_Gold;
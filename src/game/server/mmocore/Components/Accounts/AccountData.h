@@ -5,6 +5,8 @@
 
 #include <game/server/mmocore/Components/Auction/AuctionData.h>
 #include <game/server/mmocore/Utils/FieldData.h>
+#include <game/server/mmocore/Utils/Leaderboard.h>
+#include <game/server/mmocore/Utils/NicknameCache.h>
 
 struct CAccountData
 {
@@ -43,6 +45,7 @@ struct CAccountData
 	};
 
 	static std::map < int, CAccountData > ms_aData;
+	static CNicknameCache ms_Nicknames;
 };
 
 struct CAccountTempData
@@ -52,6 +55,7 @@ struct CAccountTempData
 	int m_TempID3;
 
 	CAuctionSlot m_AuctionData;
+	int m_AuctionPage;
 
 	// temp rankname for guild rank settings
 	char m_aRankGuildBuf[32];
@@ -77,4 +81,12 @@ struct CAccountTempData
 	static std::map < int, CAccountTempData > ms_aPlayerTempData;
 };
 
+struct CAccountRankingData
+{
+	static CLeaderboard ms_Level;
+	static CLeaderboard ms_Gold;
+
+	static int64 LevelScore(int Level, int Exp) { return ((int64)Level << 32) | (unsigned)Exp; }
+};
+
 #endif
\ No newline at end of file
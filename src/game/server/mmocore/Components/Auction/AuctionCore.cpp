@@ -4,18 +4,51 @@
 
 #include <engine/shared/config.h>
 #include <game/server/gamecontext.h>
+#include <game/server/mmocore/Utils/IdAllocator.h>
 
 #include <game/server/mmocore/Components/Inventory/InventoryCore.h>
 
 constexpr auto TW_AUCTION_TABLE = "tw_auction_items";
+constexpr int AUCTION_SLOTS_PER_PAGE = 15;
+
+CAuctionOrderBook CAuctionCore::ms_OrderBook;
+
+void CAuctionCore::OnInit()
+{
+	// the order book is the authority after this, changes are only written through
+	ms_OrderBook.Clear();
+	CIdAllocator::Get(ID_AUCTION_ITEMS).Prefetch();
+	const int Timestamp = time_timestamp();
+	ResultPtr pRes = Database->Execute<DB::SELECT>("*", TW_AUCTION_TABLE);
+	while(pRes->next())
+	{
+		CAuctionOrder Order;
+		Order.m_ID = pRes->getInt("ID");
+		Order.m_ItemID = pRes->getInt("ItemID");
+		Order.m_Value = pRes->getInt("ItemValue");
+		Order.m_Enchant = pRes->getInt("Enchant");
+		Order.m_Price = pRes->getInt("Price");
+		Order.m_UserID = pRes->getInt("UserID");
+		Order.m_ValidUntil = (int)pRes->getInt64("ValidUntil");
+		if(Order.m_UserID <= 0)
+			continue;
+
+		// slots from before the expiry was stored get a full term
+		if(Order.m_ValidUntil <= 0)
+			Order.m_ValidUntil = Timestamp + g_Config.m_SvTimeAuctionSlot * 60;
+		ms_OrderBook.Add(Order);
+	}
+
+	Job()->ShowLoadingProgress("Auction slots", ms_OrderBook.Num());
+}
 
 void CAuctionCore::OnTick()
 {
-	//if(GS()->GetWorldID() == MAIN_WORLD_ID) TODO: fix and rebuild me
-	//{
-	//	if(Server()->Tick() % (1 * Server()->TickSpeed() * (g_Config.m_SvTimeCheckAuction * 60)) == 0)
-	//		CheckAuctionTime();
-	//}
+	if(GS()->GetWorldID() == MAIN_WORLD_ID)
+	{
+		if(Server()->Tick() % (Server()->TickSpeed() * (g_Config.m_SvTimeCheckAuction * 60)) == 0)
+			CheckAuctionTime();
+	}
 }
 
 bool CAuctionCore::OnHandleTile(CCharacter* pChr, int IndexCollision)
@@ -101,6 +134,13 @@ bool CAuctionCore::OnHandleVoteCommands(CPlayer* pPlayer, const char* CMD, const
 		return true;
 	}
 
+	if(PPSTR(CMD, "AUCTION_PAGE") == 0)
+	{
+		pPlayer->GetTempData().m_AuctionPage = max(0, VoteID);
+		GS()->StrongUpdateVotes(ClientID, pPlayer->m_OpenVoteMenu);
+		return true;
+	}
+
 	if(PPSTR(CMD, "AUCTION_COUNT") == 0)
 	{
 		// if there are fewer items installed, we set the number of items.
@@ -166,18 +206,17 @@ bool CAuctionCore::OnHandleVoteCommands(CPlayer* pPlayer, const char* CMD, const
 void CAuctionCore::CreateAuctionSlot(CPlayer* pPlayer, CAuctionSlot* pAuctionData)
 {
 	const int ClientID = pPlayer->GetCID();
+	const int UserID = pPlayer->Acc().m_UserID;
 
 	// check the number of slots whether everything is occupied or not
-	ResultPtr pResCheck = Database->Execute<DB::SELECT>("ID", "tw_auction_items", "WHERE UserID > '0' LIMIT %d", g_Config.m_SvMaxMasiveAuctionSlots);
-	if((int)pResCheck->rowsCount() >= g_Config.m_SvMaxMasiveAuctionSlots)
+	if(ms_OrderBook.Num() >= g_Config.m_SvMaxMasiveAuctionSlots)
 	{
 		GS()->Chat(ClientID, "Auction has run out of slots, wait for the release of slots!");
 		return;
 	}
 
 	// check your slots
-	ResultPtr pResCheck2 = Database->Execute<DB::SELECT>("ID", "tw_auction_items", "WHERE UserID = '%d' LIMIT %d", pPlayer->Acc().m_UserID, g_Config.m_SvMaxAuctionSlots);
-	const int ValueSlot = (int)pResCheck2->rowsCount();
+	const int ValueSlot = ms_OrderBook.NumBySeller(UserID);
 	if(ValueSlot >= g_Config.m_SvMaxAuctionSlots)
 	{
 		GS()->Chat(ClientID, "You use all open the slots in your auction!");
@@ -185,13 +224,19 @@ void CAuctionCore::CreateAuctionSlot(CPlayer* pPlayer, CAuctionSlot* pAuctionDat
 	}
 
 	// we check if the item is in the auction
-	ResultPtr pResCheck3 = Database->Execute<DB::SELECT>("ID", TW_AUCTION_TABLE, "WHERE ItemID = '%d' AND UserID = '%d'", pAuctionData->GetItem()->GetID(), pPlayer->Acc().m_UserID);
-	if(pResCheck3->next())
+	if(ms_OrderBook.HasSellerItem(UserID, pAuctionData->GetItem()->GetID()))
 	{
 		GS()->Chat(ClientID, "Your same item found in the database, need reopen the slot!");
 		return;
 	}
 
+	const int SlotID = CIdAllocator::Get(ID_AUCTION_ITEMS).Allocate();
+	if(SlotID <= 0)
+	{
+		GS()->Chat(ClientID, "The auction is not available right now, try again later.");
+		return;
+	}
+
 	// if the money for the slot auction is withdrawn
 	if(!pPlayer->SpendCurrency(g_Config.m_SvAuctionPriceSlot))
 		return;
@@ -201,8 +246,18 @@ void CAuctionCore::CreateAuctionSlot(CPlayer* pPlayer, CAuctionSlot* pAuctionDat
 	CPlayerItem* pPlayerItem = pPlayer->GetItem(pAuctionItem->GetID());
 	if(pPlayerItem->GetValue() >= pAuctionItem->GetValue() && pPlayerItem->Remove(pAuctionItem->GetValue()))
 	{
-		Database->Execute<DB::INSERT>(TW_AUCTION_TABLE, "(ItemID, Price, ItemValue, UserID, Enchant) VALUES ('%d', '%d', '%d', '%d', '%d')",
-			pAuctionItem->GetID(), pAuctionData->GetPrice(), pAuctionItem->GetValue(), pPlayer->Acc().m_UserID, pAuctionItem->GetEnchant());
+		CAuctionOrder Order;
+		Order.m_ID = SlotID;
+		Order.m_ItemID = pAuctionItem->GetID();
+		Order.m_Value = pAuctionItem->GetValue();
+		Order.m_Enchant = pAuctionItem->GetEnchant();
+		Order.m_Price = pAuctionData->GetPrice();
+		Order.m_UserID = UserID;
+		Order.m_ValidUntil = time_timestamp() + g_Config.m_SvTimeAuctionSlot * 60;
+		ms_OrderBook.Add(Order);
+
+		Database->Execute<DB::INSERT>(TW_AUCTION_TABLE, "(ID, ItemID, Price, ItemValue, UserID, Enchant, ValidUntil) VALUES ('%d', '%d', '%d', '%d', '%d', '%d', '%d')",
+			Order.m_ID, Order.m_ItemID, Order.m_Price, Order.m_Value, Order.m_UserID, Order.m_Enchant, Order.m_ValidUntil);
 
 		const int AvailableSlot = (g_Config.m_SvMaxAuctionSlots - ValueSlot) - 1;
 		GS()->Chat(-1, "{STR} created a slot [{STR}x{VAL}] auction.", Server()->ClientName(ClientID), pPlayerItem->Info()->GetName(), pAuctionItem->GetValue());
@@ -210,69 +265,63 @@ void CAuctionCore::CreateAuctionSlot(CPlayer* pPlayer, CAuctionSlot* pAuctionDat
 	}
 }
 
-void CAuctionCore::CheckAuctionTime() const
+void CAuctionCore::CheckAuctionTime()
 {
-	ResultPtr pRes = Database->Execute<DB::SELECT>("*", TW_AUCTION_TABLE, "WHERE UserID > 0 AND DATE_SUB(NOW(),INTERVAL %d MINUTE) > ValidUntil", g_Config.m_SvTimeAuctionSlot);
-	int ReleaseSlots = (int)pRes->rowsCount();
-	while(pRes->next())
+	std::vector < CAuctionOrder > aExpired;
+	ms_OrderBook.PopExpired(time_timestamp(), aExpired);
+	for(const CAuctionOrder& Order : aExpired)
 	{
-		const int ID = pRes->getInt("ID");
-		const ItemIdentifier ItemID = pRes->getInt("ItemID");
-		const int Value = pRes->getInt("ItemValue");
-		const int Enchant = pRes->getInt("Enchant");
-		const int UserID = pRes->getInt("UserID");
-		GS()->SendInbox("Auctionist", UserID, "Auction expired", "Your slot has expired", ItemID, Value, Enchant);
-		Database->Execute<DB::REMOVE>(TW_AUCTION_TABLE, "WHERE ID = '%d'", ID);
+		GS()->SendInbox("Auctionist", Order.m_UserID, "Auction expired", "Your slot has expired", Order.m_ItemID, Order.m_Value, Order.m_Enchant);
+		Database->Execute<DB::REMOVE>(TW_AUCTION_TABLE, "WHERE ID = '%d'", Order.m_ID);
 	}
 
-	if(ReleaseSlots)
+	if(!aExpired.empty())
 	{
-		GS()->Chat(-1, "Auction {INT} slots has been released!", ReleaseSlots);
+		GS()->Chat(-1, "Auction {INT} slots has been released!", (int)aExpired.size());
 	}
 }
 
 bool CAuctionCore::BuyItem(CPlayer* pPlayer, int ID)
 {
 	const int ClientID = pPlayer->GetCID();
-	ResultPtr pRes = Database->Execute<DB::SELECT>("*", TW_AUCTION_TABLE, "WHERE ID = '%d'", ID);
-	if(!pRes->next())
-		return false;
-
-	// checking for enchanted items
-	const ItemIdentifier ItemID = pRes->getInt("ItemID");
-	CPlayerItem* pPlayerItem = pPlayer->GetItem(ItemID);
-	if(pPlayerItem->HasItem() && pPlayerItem->Info()->IsEnchantable())
+	CAuctionOrder Order;
+	if(!ms_OrderBook.Find(ID, &Order))
 	{
-		GS()->Chat(ClientID, "Enchant item maximal count x1 in a backpack!");
+		GS()->Chat(ClientID, "This slot has already been closed!");
 		return false;
 	}
 
-	const int UserID = pRes->getInt("UserID");
-	const int Price = pRes->getInt("Price");
-	const int Value = pRes->getInt("ItemValue");
-	const int Enchant = pRes->getInt("Enchant");
-
 	// if it is a player slot then close the slot
-	if(UserID == pPlayer->Acc().m_UserID)
+	if(Order.m_UserID == pPlayer->Acc().m_UserID)
 	{
+		ms_OrderBook.Remove(ID);
 		GS()->Chat(ClientID, "You closed auction slot!");
-		GS()->SendInbox("Auctionist", pPlayer, "Auction Alert", "You have bought a item, or canceled your slot", ItemID, Value, Enchant);
-		Database->Execute<DB::REMOVE>(TW_AUCTION_TABLE, "WHERE ItemID = '%d' AND UserID = '%d'", ItemID, UserID);
+		GS()->SendInbox("Auctionist", pPlayer, "Auction Alert", "You have bought a item, or canceled your slot", Order.m_ItemID, Order.m_Value, Order.m_Enchant);
+		Database->Execute<DB::REMOVE>(TW_AUCTION_TABLE, "WHERE ID = '%d'", ID);
 		return true;
 	}
 
+	// checking for enchanted items
+	CPlayerItem* pPlayerItem = pPlayer->GetItem(Order.m_ItemID);
+	if(pPlayerItem->HasItem() && pPlayerItem->Info()->IsEnchantable())
+	{
+		GS()->Chat(ClientID, "Enchant item maximal count x1 in a backpack!");
+		return false;
+	}
+
 	// player purchasing
-	if(!pPlayer->SpendCurrency(Price))
+	if(!pPlayer->SpendCurrency(Order.m_Price))
 		return false;
 
 	// information & exchange item
+	ms_OrderBook.Remove(ID);
 	char aBuf[128];
-	str_format(aBuf, sizeof(aBuf), "Your [Slot %sx%d] was sold!", pPlayerItem->Info()->GetName(), Value);
-	GS()->SendInbox("Auctionist", UserID, "Auction Sell", aBuf, itGold, Price, 0);
-	Database->Execute<DB::REMOVE>(TW_AUCTION_TABLE, "WHERE ItemID = '%d' AND UserID = '%d'", ItemID, UserID);
+	str_format(aBuf, sizeof(aBuf), "Your [Slot %sx%d] was sold!", pPlayerItem->Info()->GetName(), Order.m_Value);
+	GS()->SendInbox("Auctionist", Order.m_UserID, "Auction Sell", aBuf, itGold, Order.m_Price, 0);
+	Database->Execute<DB::REMOVE>(TW_AUCTION_TABLE, "WHERE ID = '%d'", ID);
 
-	pPlayerItem->Add(Value, 0, Enchant);
-	GS()->Chat(ClientID, "You buy {STR}x{VAL}.", pPlayerItem->Info()->GetName(), Value);
+	pPlayerItem->Add(Order.m_Value, 0, Order.m_Enchant);
+	GS()->Chat(ClientID, "You buy {STR}x{VAL}.", pPlayerItem->Info()->GetName(), Order.m_Value);
 	return true;
 }
 
@@ -285,44 +334,59 @@ void CAuctionCore::ShowAuction(CPlayer* pPlayer)
 	GS()->ShowVotesItemValueInformation(pPlayer);
 	GS()->AV(ClientID, "null");
 
-	bool FoundItems = false;
-	int HideID = (int)(NUM_TAB_MENU + CItemDescription::Data().size() + 400);
-	ResultPtr pRes = Database->Execute<DB::SELECT>("*", TW_AUCTION_TABLE, "WHERE UserID > 0 ORDER BY Price");
-	while(pRes->next())
+	std::vector < CAuctionOrder > aOrders;
+	int& Page = pPlayer->GetTempData().m_AuctionPage;
+	int Total = ms_OrderBook.GetPage(Page, AUCTION_SLOTS_PER_PAGE, aOrders);
+	const int NumPages = max(1, (Total + AUCTION_SLOTS_PER_PAGE - 1) / AUCTION_SLOTS_PER_PAGE);
+	if(Page >= NumPages)
 	{
-		const int ID = pRes->getInt("ID");
-		const ItemIdentifier ItemID = pRes->getInt("ItemID");
-		const int Price = pRes->getInt("Price");
-		const int Enchant = pRes->getInt("Enchant");
-		const int ItemValue = pRes->getInt("ItemValue");
-		const int UserID = pRes->getInt("UserID");
-		CItemDescription* pItemInfo = GS()->GetItemInfo(ItemID);
+		// slots were sold since the page was opened
+		Page = NumPages - 1;
+		Total = ms_OrderBook.GetPage(Page, AUCTION_SLOTS_PER_PAGE, aOrders);
+	}
+
+	std::vector<int> aSellers;
+	for(const CAuctionOrder& Order : aOrders)
+		aSellers.push_back(Order.m_UserID);
+	Job()->PrefetchPlayerNames(aSellers);
 
+	int HideID = (int)(NUM_TAB_MENU + CItemDescription::Data().size() + 400);
+	for(const CAuctionOrder& Order : aOrders)
+	{
+		CItemDescription* pItemInfo = GS()->GetItemInfo(Order.m_ItemID);
 		if(pItemInfo->IsEnchantable())
 		{
 			char aEnchantBuf[16];
-			pItemInfo->StrFormatEnchantLevel(aEnchantBuf, sizeof(aEnchantBuf), Enchant);
+			pItemInfo->StrFormatEnchantLevel(aEnchantBuf, sizeof(aEnchantBuf), Order.m_Enchant);
 			GS()->AVH(ClientID, HideID, "{STR}{STR} {STR} - {VAL} gold",
-				(pPlayer->GetItem(ItemID)->GetValue() > 0 ? "✔ " : "\0"), pItemInfo->GetName(), (Enchant > 0 ? aEnchantBuf : "\0"), Price);
+				(pPlayer->GetItem(Order.m_ItemID)->GetValue() > 0 ? "✔ " : "\0"), pItemInfo->GetName(), (Order.m_Enchant > 0 ? aEnchantBuf : "\0"), Order.m_Price);
 
 			char aAttributes[128];
-			pItemInfo->StrFormatAttributes(pPlayer, aAttributes, sizeof(aAttributes), Enchant);
+			pItemInfo->StrFormatAttributes(pPlayer, aAttributes, sizeof(aAttributes), Order.m_Enchant);
 			GS()->AVM(ClientID, "null", NOPE, HideID, "{STR}", aAttributes);
 		}
 		else
 		{
 			GS()->AVH(ClientID, HideID, "{STR}x{VAL} ({VAL}) - {VAL} gold",
-				pItemInfo->GetName(), ItemValue, pPlayer->GetItem(ItemID)->GetValue(), Price);
+				pItemInfo->GetName(), Order.m_Value, pPlayer->GetItem(Order.m_ItemID)->GetValue(), Order.m_Price);
 		}
 
-		//GS()->AVM(ClientID, "null", NOPE, HideID, "{STR}", pItemInfo->GetDescription());
-		GS()->AVM(ClientID, "null", NOPE, HideID, "* Seller {STR}", Job()->PlayerName(UserID));
-		GS()->AVM(ClientID, "AUCTION_BUY", ID, HideID, "Buy Price {VAL} gold", Price);
-		FoundItems = true;
+		GS()->AVM(ClientID, "null", NOPE, HideID, "* Seller {STR}", Job()->PlayerName(Order.m_UserID));
+		GS()->AVM(ClientID, "AUCTION_BUY", Order.m_ID, HideID, "Buy Price {VAL} gold", Order.m_Price);
 		++HideID;
 	}
-	if(!FoundItems)
+	if(aOrders.empty())
 		GS()->AVL(ClientID, "null", "Currently there are no products.");
 
+	if(NumPages > 1)
+	{
+		GS()->AV(ClientID, "null");
+		GS()->AVM(ClientID, "null", NOPE, NOPE, "Page {INT} of {INT} ({INT} slots)", Page + 1, NumPages, Total);
+		if(Page > 0)
+			GS()->AVM(ClientID, "AUCTION_PAGE", Page - 1, NOPE, "<< Previous page");
+		if(Page + 1 < NumPages)
+			GS()->AVM(ClientID, "AUCTION_PAGE", Page + 1, NOPE, ">> Next page");
+	}
+
 	GS()->AV(ClientID, "null");
 }
@@ -5,10 +5,15 @@
 
 #include <game/server/mmocore/MmoComponent.h>
 
+#include "AuctionData.h"
+
 class CAuctionCore : public MmoComponent
 {
 	~CAuctionCore() override = default;
 
+	static CAuctionOrderBook ms_OrderBook;
+
+	void OnInit() override;
 	void OnTick() override;
 	bool OnHandleTile(CCharacter* pChr, int IndexCollision) override;
 	bool OnHandleMenulist(CPlayer* pPlayer, int Menulist, bool ReplaceMenu) override;
@@ -16,7 +21,7 @@ class CAuctionCore : public MmoComponent
 
 private:
 	void CreateAuctionSlot(CPlayer *pPlayer, class CAuctionSlot* pAuctionData);
-	void CheckAuctionTime() const;
+	void CheckAuctionTime();
 
 	bool BuyItem(CPlayer* pPlayer, int ID);
 	void ShowAuction(CPlayer* pPlayer);
@@ -1,3 +1,106 @@
 /* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "AuctionData.h"
+
+#include <limits>
+
+void CAuctionOrderBook::Clear()
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	m_aOrders.clear();
+	m_aByPrice.clear();
+	m_aBySeller.clear();
+	m_aByExpiry.clear();
+}
+
+void CAuctionOrderBook::Add(const CAuctionOrder& Order)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	const auto Iter = m_aOrders.find(Order.m_ID);
+	if(Iter != m_aOrders.end())
+		RemoveUnlocked(Iter->second);
+
+	m_aOrders[Order.m_ID] = Order;
+	m_aByPrice.emplace(Order.m_Price, Order.m_ID);
+	m_aBySeller.emplace(Order.m_UserID, Order.m_ItemID, Order.m_ID);
+	m_aByExpiry.emplace(Order.m_ValidUntil, Order.m_ID);
+}
+
+void CAuctionOrderBook::RemoveUnlocked(const CAuctionOrder& Order)
+{
+	m_aByPrice.erase({ Order.m_Price, Order.m_ID });
+	m_aBySeller.erase(std::make_tuple(Order.m_UserID, Order.m_ItemID, Order.m_ID));
+	m_aByExpiry.erase({ Order.m_ValidUntil, Order.m_ID });
+	m_aOrders.erase(Order.m_ID);
+}
+
+bool CAuctionOrderBook::Remove(int ID)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	const auto Iter = m_aOrders.find(ID);
+	if(Iter == m_aOrders.end())
+		return false;
+
+	RemoveUnlocked(Iter->second);
+	return true;
+}
+
+bool CAuctionOrderBook::Find(int ID, CAuctionOrder* pOrder) const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	const auto Iter = m_aOrders.find(ID);
+	if(Iter == m_aOrders.end())
+		return false;
+
+	*pOrder = Iter->second;
+	return true;
+}
+
+int CAuctionOrderBook::Num() const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return (int)m_aOrders.size();
+}
+
+int CAuctionOrderBook::NumBySeller(int UserID) const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	const auto Begin = m_aBySeller.lower_bound(std::make_tuple(UserID, std::numeric_limits<ItemIdentifier>::min(), std::numeric_limits<int>::min()));
+	const auto End = m_aBySeller.lower_bound(std::make_tuple(UserID + 1, std::numeric_limits<ItemIdentifier>::min(), std::numeric_limits<int>::min()));
+	return (int)std::distance(Begin, End);
+}
+
+bool CAuctionOrderBook::HasSellerItem(int UserID, ItemIdentifier ItemID) const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	const auto Iter = m_aBySeller.lower_bound(std::make_tuple(UserID, ItemID, std::numeric_limits<int>::min()));
+	return Iter != m_aBySeller.end() && std::get<0>(*Iter) == UserID && std::get<1>(*Iter) == ItemID;
+}
+
+int CAuctionOrderBook::GetPage(int Page, int PerPage, std::vector < CAuctionOrder >& aOrders) const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	aOrders.clear();
+
+	const int Skip = Page * PerPage;
+	if(Skip >= (int)m_aByPrice.size())
+		return (int)m_aByPrice.size();
+
+	auto Iter = m_aByPrice.begin();
+	std::advance(Iter, Skip);
+	for(; Iter != m_aByPrice.end() && (int)aOrders.size() < PerPage; ++Iter)
+		aOrders.push_back(m_aOrders.at(Iter->second));
+	return (int)m_aByPrice.size();
+}
+
+void CAuctionOrderBook::PopExpired(int Timestamp, std::vector < CAuctionOrder >& aOrders)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	aOrders.clear();
+	while(!m_aByExpiry.empty() && m_aByExpiry.begin()->first <= Timestamp)
+	{
+		const auto Iter = m_aOrders.find(m_aByExpiry.begin()->second);
+		aOrders.push_back(Iter->second);
+		RemoveUnlocked(Iter->second);
+	}
+}
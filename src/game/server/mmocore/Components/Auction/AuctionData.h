@@ -5,6 +5,10 @@
 
 #include <game/server/mmocore/Components/Inventory/ItemData.h>
 
+#include <mutex>
+#include <set>
+#include <tuple>
+
 class CAuctionSlot
 {
 	CItem m_Item{};
@@ -22,5 +26,48 @@ public:
 	int GetPrice() const { return m_Price; }
 };
 
+// an auction slot put up by a player
+struct CAuctionOrder
+{
+	int m_ID;
+	ItemIdentifier m_ItemID;
+	int m_Value;
+	int m_Enchant;
+	int m_Price;
+	int m_UserID;
+	int m_ValidUntil; // unix timestamp
+};
+
+/*
+	All active slots of the auction, loaded once at startup and written through to the database.
+	Indexed by price for the menu, by seller for the slot limits and by expiry time.
+	The menu is built in the vote jobs, so every access is locked.
+*/
+class CAuctionOrderBook
+{
+	std::map < int, CAuctionOrder > m_aOrders;
+	std::set < std::pair < int, int > > m_aByPrice; // price, id
+	std::set < std::tuple < int, ItemIdentifier, int > > m_aBySeller; // user, item, id
+	std::set < std::pair < int, int > > m_aByExpiry; // valid until, id
+	mutable std::mutex m_Mutex;
+
+	void RemoveUnlocked(const CAuctionOrder& Order);
+
+public:
+	void Clear();
+	void Add(const CAuctionOrder& Order);
+	bool Remove(int ID);
+	bool Find(int ID, CAuctionOrder* pOrder) const;
+
+	int Num() const;
+	int NumBySeller(int UserID) const;
+	bool HasSellerItem(int UserID, ItemIdentifier ItemID) const;
+
+	// slots sorted by price, returns the total number of slots
+	int GetPage(int Page, int PerPage, std::vector < CAuctionOrder >& aOrders) const;
+	// removes and returns the slots that are no longer valid
+	void PopExpired(int Timestamp, std::vector < CAuctionOrder >& aOrders);
+};
+
 #endif
 
@@ -95,6 +95,14 @@ void CBotCore::InitQuestBots(const char* pWhereLocalWorld)
 		QuestBot.m_InteractiveTemp = pRes->getInt("InteractionTemp");
 		//QuestBot.m_GenerateNick = pRes->getBoolean("GenerateSubName");
 		QuestBot.m_EventJsonData = pRes->getString("EventData").c_str();
+		JsonTools::parseFromString(QuestBot.m_EventJsonData, [&](nlohmann::json& pJson)
+		{
+			if(pJson.find("effect") != pJson.end())
+			{
+				QuestBot.m_EventEffectID = CEffectRegistry::Get().Intern(pJson["effect"].value("name", "").c_str());
+				QuestBot.m_EventEffectSeconds = pJson["effect"].value("seconds", 0);
+			}
+		});
 		sscanf(pRes->getString("Amount").c_str(), "|%d|%d|%d|%d|%d|%d|",
 			&QuestBot.m_aItemSearchValue[0], &QuestBot.m_aItemSearchValue[1], &QuestBot.m_aItemGivesValue[0], &QuestBot.m_aItemGivesValue[1], &QuestBot.m_aNeedMobValue[0], &QuestBot.m_aNeedMobValue[1]);
 		QuestBot.m_HasAction = false;
@@ -105,6 +105,8 @@ public:
 	bool m_GenerateNick{};
 	bool m_HasAction{};
 	std::string m_EventJsonData{};
+	int m_EventEffectID{EFFECT_NONE};
+	int m_EventEffectSeconds{};
 	std::vector<CDialog> m_aDialogs {};
 
 	const char* GetName() const { return DataBotInfo::ms_aDataBot[m_BotID].m_aNameBot; }
@@ -120,11 +122,12 @@ class CMobBuffDebuff
 {
 	float m_Chance{};
 	std::string m_Effect{};
+	int m_EffectID{};
 	std::tuple<int, int> m_Time{};
 
 public:
 	CMobBuffDebuff() = default;
-	CMobBuffDebuff(float Chance, std::string Effect, std::tuple<int, int> Time) : m_Chance(Chance), m_Effect(Effect), m_Time(Time) {}
+	CMobBuffDebuff(float Chance, std::string Effect, std::tuple<int, int> Time) : m_Chance(Chance), m_Effect(Effect), m_EffectID(CEffectRegistry::Get().Intern(Effect.c_str())), m_Time(Time) {}
 
 	enum
 	{
@@ -133,6 +136,7 @@ public:
 	};
 
 	const char* getEffect() const { return m_Effect.c_str(); }
+	int getEffectID() const { return m_EffectID; }
 	int getTime() const
 	{
 		int Range = std::get<RANGE>(m_Time);
@@ -120,7 +120,7 @@ void CCraftCore::CraftItem(CPlayer *pPlayer, CCraftItem* pCraft) const
 		if(pPlayer->GetItem(RequiredItem)->GetValue() < RequiredItem.GetValue())
 		{
 			const int ItemLeft = (RequiredItem.GetValue() - pPlayer->GetItem(RequiredItem)->GetValue());
-			GS()->Server()->Localization()->Format(Buffer, pPlayer->GetLanguage(), "{STR}x{VAL} ", RequiredItem.Info()->GetName(), ItemLeft);
+			GS()->Server()->Localization()->Format(Buffer, pPlayer->GetLanguageInfo(), "{STR}x{VAL} ", RequiredItem.Info()->GetName(), ItemLeft);
 		}
 	}
 	if(Buffer.length() > 0)
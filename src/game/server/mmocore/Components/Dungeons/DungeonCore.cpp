@@ -164,13 +164,30 @@ void DungeonCore::SaveDungeonRecord(CPlayer* pPlayer, int DungeonID, CPlayerDung
 void DungeonCore::ShowDungeonTop(CPlayer* pPlayer, int DungeonID, int HideID) const
 {
 	const int ClientID = pPlayer->GetCID();
+	struct CRecord
+	{
+		int m_UserID;
+		int m_Seconds;
+		int m_PassageHelp;
+	};
+
+	std::vector<CRecord> aRecords;
+	std::vector<int> aAccountIDs;
 	ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_dungeons_records", "WHERE DungeonID = '%d' ORDER BY Seconds ASC LIMIT 5", DungeonID);
 	while (pRes->next())
 	{
-		const int Rank = pRes->getRow();
-		const int UserID = pRes->getInt("UserID");
-		const int BaseSeconds = pRes->getInt("Seconds");
-		const int BasePassageHelp = pRes->getInt("PassageHelp");
+		aRecords.push_back({ pRes->getInt("UserID"), pRes->getInt("Seconds"), pRes->getInt("PassageHelp") });
+		aAccountIDs.push_back(aRecords.back().m_UserID);
+	}
+	Job()->PrefetchPlayerNames(aAccountIDs);
+
+	int Rank = 0;
+	for(const CRecord& Record : aRecords)
+	{
+		++Rank;
+		const int UserID = Record.m_UserID;
+		const int BaseSeconds = Record.m_Seconds;
+		const int BasePassageHelp = Record.m_PassageHelp;
 
 		const int Minutes = BaseSeconds / 60;
 		const int Seconds = BaseSeconds - (BaseSeconds / 60 * 60);
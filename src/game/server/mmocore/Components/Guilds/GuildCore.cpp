@@ -4,6 +4,7 @@
 
 #include <engine/shared/config.h>
 #include <game/server/gamecontext.h>
+#include <game/server/mmocore/Utils/IdAllocator.h>
 
 #include <game/server/mmocore/GameEntities/decoration_houses.h>
 #include "Entities/GuildDoor.h"
@@ -27,6 +28,10 @@ void GuildCore::LoadGuildRank(int GuildID)
 
 void GuildCore::OnInit()
 {
+	CIdAllocator::Get(ID_GUILDS).Prefetch();
+	CIdAllocator::Get(ID_GUILD_RANKS).Prefetch();
+	CIdAllocator::Get(ID_GUILD_DECORATIONS).Prefetch();
+
 	const auto InitGuilds = Database->Prepare<DB::SELECT>("*", "tw_guilds");
 	InitGuilds->AtExecute([this](ResultPtr pRes)
 	{
@@ -41,8 +46,27 @@ void GuildCore::OnInit()
 			str_copy(CGuildData::ms_aGuild[GuildID].m_aName, pRes->getString("Name").c_str(), sizeof(CGuildData::ms_aGuild[GuildID].m_aName));
 
 			CGuildData::ms_aGuild[GuildID].m_UpgradeData.initFields(&pRes);
+			CGuildData::UpdateRanking(GuildID);
+			CGuildData::IndexName(GuildID);
 			LoadGuildRank(GuildID);
 		}
+
+		// members and invites are kept in memory after this
+		ResultPtr pResMembers = Database->Execute<DB::SELECT>("ID, GuildID, GuildRank, GuildDeposit", "tw_accounts_data", "WHERE GuildID > '0'");
+		while(pResMembers->next())
+		{
+			const int GuildID = pResMembers->getInt("GuildID");
+			if(CGuildData::ms_aGuild.find(GuildID) != CGuildData::ms_aGuild.end())
+				CGuildData::AddMember(GuildID, pResMembers->getInt("ID"), pResMembers->getInt("GuildRank"), pResMembers->getInt("GuildDeposit"));
+		}
+
+		ResultPtr pResInvites = Database->Execute<DB::SELECT>("GuildID, UserID", "tw_guilds_invites");
+		while(pResInvites->next())
+		{
+			const auto pGuild = CGuildData::ms_aGuild.find(pResInvites->getInt("GuildID"));
+			if(pGuild != CGuildData::ms_aGuild.end())
+				pGuild->second.m_aInvites.insert(pResInvites->getInt("UserID"));
+		}
 		Job()->ShowLoadingProgress("Guilds", CGuildData::ms_aGuild.size());
 	});
 }
@@ -326,6 +350,10 @@ bool GuildCore::OnHandleVoteCommands(CPlayer* pPlayer, const char* CMD, int Vote
 		const int SenderID = VoteID;
 		if(JoinGuild(SenderID, GuildID))
 		{
+			{
+				std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+				CGuildData::ms_aGuild[GuildID].m_aInvites.erase(SenderID);
+			}
 			Database->Execute<DB::REMOVE>("tw_guilds_invites", "WHERE GuildID = '%d' AND UserID = '%d'", GuildID, SenderID);
 			GS()->SendInbox(Server()->ClientName(ClientID),SenderID, CGuildData::ms_aGuild[GuildID].m_aName, "You were accepted to join guild");
 			GS()->StrongUpdateVotes(ClientID, pPlayer->m_OpenVoteMenu);
@@ -347,6 +375,10 @@ bool GuildCore::OnHandleVoteCommands(CPlayer* pPlayer, const char* CMD, int Vote
 
 		const int SenderID = VoteID;
 		GS()->Chat(ClientID, "You reject invite.");
+		{
+			std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+			CGuildData::ms_aGuild[GuildID].m_aInvites.erase(SenderID);
+		}
 		Database->Execute<DB::REMOVE>("tw_guilds_invites", "WHERE GuildID = '%d' AND UserID = '%d'", GuildID, SenderID);
 		GS()->SendInbox(Server()->ClientName(ClientID), SenderID, CGuildData::ms_aGuild[GuildID].m_aName, "You were denied join guild");
 		GS()->UpdateVotes(ClientID, MENU_GUILD);
@@ -485,6 +517,10 @@ bool GuildCore::OnHandleVoteCommands(CPlayer* pPlayer, const char* CMD, int Vote
 		if(pPlayer->SpendCurrency(Get))
 		{
 			AddMoneyBank(GuildID, Get);
+			{
+				std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+				CGuildData::ms_aGuild[GuildID].m_aMembers[pPlayer->Acc().m_UserID].m_Deposit += Get;
+			}
 			Database->Execute<DB::UPDATE>("tw_accounts_data", "GuildDeposit = GuildDeposit + '%d' WHERE ID = '%d'", Get, pPlayer->Acc().m_UserID);
 			GS()->ChatGuild(GuildID, "{STR} deposit in treasury {VAL}gold.", Server()->ClientName(ClientID), Get);
 			AddHistoryGuild(GuildID, "'%s' added to bank %dgold.", Server()->ClientName(ClientID), Get);
@@ -641,13 +677,7 @@ void GuildCore::TickHousingText()
 ######################################################################### */
 int GuildCore::SearchGuildByName(const char* pGuildName) const
 {
-	std::string SearchName(pGuildName); // I do not trust him with such important things xd
-	auto pItem = std::find_if(CGuildData::ms_aGuild.begin(), CGuildData::ms_aGuild.end(), [SearchName](std::pair< int, CGuildData> pCheck)
-	{
-		std::string RealName(pCheck.second.m_aName);
-		return SearchName.compare(RealName) == 0;
-	});
-	return pItem != CGuildData::ms_aGuild.end() ? pItem->first : -1;
+	return CGuildData::FindByName(pGuildName);
 }
 
 const char *GuildCore::GuildName(int GuildID) const
@@ -696,12 +726,13 @@ bool GuildCore::AddDecorationHouse(int DecoID, int GuildID, vec2 Position)
 		return false;
 
 	int HouseID = GetGuildHouseID(GuildID);
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_guilds_decorations", "WHERE HouseID = '%d'", HouseID);
-	if ((int)pRes->rowsCount() >= g_Config.m_SvLimitDecoration)
+	const auto DecorationsNum = std::count_if(m_DecorationHouse.begin(), m_DecorationHouse.end(), [HouseID](const auto& Decoration) { return Decoration.second->m_HouseID == HouseID; });
+	if ((int)DecorationsNum >= g_Config.m_SvLimitDecoration)
 		return false;
 
-	ResultPtr pRes2 = Database->Execute<DB::SELECT>("ID", "tw_guilds_decorations", "ORDER BY ID DESC LIMIT 1");
-	int InitID = (pRes2->next() ? pRes2->getInt("ID") + 1 : 1);
+	const int InitID = CIdAllocator::Get(ID_GUILD_DECORATIONS).Allocate();
+	if(InitID <= 0)
+		return false;
 	Database->Execute<DB::INSERT>("tw_guilds_decorations", "(ID, DecoID, HouseID, PosX, PosY, WorldID) VALUES ('%d', '%d', '%d', '%d', '%d', '%d')",
 		InitID, DecoID, HouseID, (int)Position.x, (int)Position.y, GS()->GetWorldID());
 	m_DecorationHouse[InitID] = new CDecorationHouses(&GS()->m_World, Position, HouseID, DecoID);
@@ -753,8 +784,7 @@ void GuildCore::CreateGuild(CPlayer *pPlayer, const char *pGuildName)
 
 	// we check the availability of the guild's name
 	CSqlString<64> GuildName(pGuildName);
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_guilds", "WHERE Name = '%s'", GuildName.cstr());
-	if(pRes->next())
+	if(CGuildData::FindByName(pGuildName) > 0)
 	{
 		GS()->Chat(ClientID, "This guild name already useds!");
 		return;
@@ -768,8 +798,13 @@ void GuildCore::CreateGuild(CPlayer *pPlayer, const char *pGuildName)
 	}
 
 	// get ID for initialization
-	ResultPtr pResID = Database->Execute<DB::SELECT>("ID", "tw_guilds", "ORDER BY ID DESC LIMIT 1");
-	const int InitID = pResID->next() ? pResID->getInt("ID")+1 : 1; // TODO: thread save ? hm need for table all time auto increment = 1; NEED FIX IT -- use some kind of uuid
+	const int InitID = CIdAllocator::Get(ID_GUILDS).Allocate();
+	if(InitID <= 0)
+	{
+		pPlayer->GetItem(itTicketGuild)->Add(1);
+		GS()->Chat(ClientID, "The guild could not be created, try again later!");
+		return;
+	}
 
 	// initialize the guild
 	str_copy(CGuildData::ms_aGuild[InitID].m_aName, GuildName.cstr(), sizeof(CGuildData::ms_aGuild[InitID].m_aName));
@@ -780,6 +815,9 @@ void GuildCore::CreateGuild(CPlayer *pPlayer, const char *pGuildName)
 	CGuildData::ms_aGuild[InitID].m_Score = 0;
 	CGuildData::ms_aGuild[InitID].m_UpgradeData(CGuildData::AVAILABLE_SLOTS, 0).m_Value = 2;
 	CGuildData::ms_aGuild[InitID].m_UpgradeData(CGuildData::CHAIR_EXPERIENCE, 0).m_Value = 1;
+	CGuildData::UpdateRanking(InitID);
+	CGuildData::IndexName(InitID);
+	CGuildData::AddMember(InitID, pPlayer->Acc().m_UserID);
 	pPlayer->Acc().m_GuildID = InitID;
 
 	// we create a guild in the table
@@ -791,10 +829,9 @@ void GuildCore::CreateGuild(CPlayer *pPlayer, const char *pGuildName)
 
 void GuildCore::DisbandGuild(int GuildID)
 {
-	ResultPtr pResCheck = Database->Execute<DB::SELECT>("ID", "tw_guilds", "WHERE ID = '%d'", GuildID);
-	if(!pResCheck)
+	if(CGuildData::ms_aGuild.find(GuildID) == CGuildData::ms_aGuild.end())
 	{
-		dbg_msg("Guild", "The guild is disassembled with identifier %d, but it was not found in the Database->", GuildID);
+		dbg_msg("Guild", "The guild is disassembled with identifier %d, but it was not found.", GuildID);
 		return;
 	}
 
@@ -821,14 +858,24 @@ void GuildCore::DisbandGuild(int GuildID)
 		GS()->UpdateVotes(i, MENU_MAIN);
 	}
 	Database->Execute<DB::UPDATE>("tw_accounts_data", "GuildID = NULL, GuildRank = NULL, GuildDeposit = '0' WHERE GuildID = '%d'", GuildID);
-	CGuildData::ms_aGuild.erase(GuildID);
+	Database->Execute<DB::REMOVE>("tw_guilds_invites", "WHERE GuildID = '%d'", GuildID);
+	{
+		std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+		for(const auto& [AccountID, Member] : CGuildData::ms_aGuild[GuildID].m_aMembers)
+			CGuildData::ms_aAccountGuild.erase(AccountID);
+		CGuildData::UnindexName(GuildID);
+		CGuildData::ms_aGuild.erase(GuildID);
+	}
+	CGuildData::RemoveRanking(GuildID);
 }
 
 bool GuildCore::JoinGuild(int AccountID, int GuildID)
 {
 	const char *pPlayerName = Job()->PlayerName(AccountID);
-	ResultPtr pResCheckJoin = Database->Execute<DB::SELECT>("ID", "tw_accounts_data", "WHERE ID = '%d' AND GuildID IS NOT NULL", AccountID);
-	if(pResCheckJoin->next())
+
+	// the check and the join are one step, the member maps are also used by the vote jobs
+	std::unique_lock<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+	if(CGuildData::ms_aAccountGuild.find(AccountID) != CGuildData::ms_aAccountGuild.end())
 	{
 		GS()->ChatAccount(AccountID, "You already in guild group!");
 		GS()->ChatGuild(GuildID, "{STR} already joined your or another guilds", pPlayerName);
@@ -836,8 +883,7 @@ bool GuildCore::JoinGuild(int AccountID, int GuildID)
 	}
 
 	// check the number of slots available
-	ResultPtr pResCheckSlot = Database->Execute<DB::SELECT>("ID", "tw_accounts_data", "WHERE GuildID = '%d'", GuildID);
-	if((int)pResCheckSlot->rowsCount() >= CGuildData::ms_aGuild[GuildID].m_UpgradeData(CGuildData::AVAILABLE_SLOTS, 0).m_Value)
+	if(GetGuildPlayerValue(GuildID) >= CGuildData::ms_aGuild[GuildID].m_UpgradeData(CGuildData::AVAILABLE_SLOTS, 0).m_Value)
 	{
 		GS()->ChatAccount(AccountID, "You don't joined [No slots for join]");
 		GS()->ChatGuild(GuildID, "{STR} don't joined [No slots for join]", pPlayerName);
@@ -845,6 +891,9 @@ bool GuildCore::JoinGuild(int AccountID, int GuildID)
 	}
 
 	// we update and get the data
+	CGuildData::AddMember(GuildID, AccountID);
+	Lock.unlock();
+
 	CPlayer *pPlayer = GS()->GetPlayerFromUserID(AccountID);
 	if(pPlayer)
 	{
@@ -859,32 +908,36 @@ bool GuildCore::JoinGuild(int AccountID, int GuildID)
 
 void GuildCore::ExitGuild(int AccountID)
 {
+	// we check the account and its guild
+	std::unique_lock<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+	const auto Iter = CGuildData::ms_aAccountGuild.find(AccountID);
+	if(Iter == CGuildData::ms_aAccountGuild.end())
+		return;
+
 	// we check if the clan leader leaves
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_guilds", "WHERE UserID = '%d'", AccountID);
-	if (pRes->next())
+	const int GuildID = Iter->second;
+	if(CGuildData::ms_aGuild[GuildID].m_UserID == AccountID)
 	{
+		Lock.unlock();
 		GS()->ChatAccount(AccountID, "A leader cannot leave his guild group!");
 		return;
 	}
 
-	// we check the account and its guild
-	ResultPtr pResExit = Database->Execute<DB::SELECT>("GuildID", "tw_accounts_data", "WHERE ID = '%d'", AccountID);
-	if (pResExit->next())
-	{
-		// we write to the guild that the player has left the guild
-		const int GuildID = pResExit->getInt("GuildID");
-		GS()->ChatGuild(GuildID, "{STR} left the Guild!", Job()->PlayerName(AccountID));
-		AddHistoryGuild(GuildID, "'%s' exit or kicked.", Job()->PlayerName(AccountID));
+	// we write to the guild that the player has left the guild
+	CGuildData::RemoveMember(AccountID);
+	Lock.unlock();
+	GS()->ChatGuild(GuildID, "{STR} left the Guild!", Job()->PlayerName(AccountID));
+	AddHistoryGuild(GuildID, "'%s' exit or kicked.", Job()->PlayerName(AccountID));
 
-		// we update the player's information
-		CPlayer *pPlayer = GS()->GetPlayerFromUserID(AccountID);
-		if(pPlayer)
-		{
-			pPlayer->Acc().m_GuildID = 0;
-			GS()->UpdateVotes(pPlayer->GetCID(), MENU_MAIN);
-		}
-		Database->Execute<DB::UPDATE>("tw_accounts_data", "GuildID = NULL, GuildRank = NULL, GuildDeposit = '0' WHERE ID = '%d'", AccountID);
+	// we update the player's information
+	CPlayer *pPlayer = GS()->GetPlayerFromUserID(AccountID);
+	if(pPlayer)
+	{
+		pPlayer->Acc().m_GuildID = 0;
+		pPlayer->Acc().m_GuildRank = 0;
+		GS()->UpdateVotes(pPlayer->GetCID(), MENU_MAIN);
 	}
+	Database->Execute<DB::UPDATE>("tw_accounts_data", "GuildID = NULL, GuildRank = NULL, GuildDeposit = '0' WHERE ID = '%d'", AccountID);
 }
 
 void GuildCore::ShowMenuGuild(CPlayer *pPlayer) const
@@ -956,24 +1009,34 @@ void GuildCore::ShowGuildPlayers(CPlayer* pPlayer, int GuildID)
 
 	GS()->AVL(ClientID, "null", "List players of {STR}", CGuildData::ms_aGuild[GuildID].m_aName);
 
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID, Nick, GuildRank, GuildDeposit", "tw_accounts_data", "WHERE GuildID = '%d'", GuildID);
-	while (pRes->next())
+	std::vector< std::pair< int, CGuildMemberData > > aMembers;
+	std::vector< int > aAccountIDs;
+	{
+		std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+		for(const auto& Member : CGuildData::ms_aGuild[GuildID].m_aMembers)
+		{
+			aMembers.push_back(Member);
+			aAccountIDs.push_back(Member.first);
+		}
+	}
+	Job()->PrefetchPlayerNames(aAccountIDs);
+
+	for(const auto& [PlayerAccountID, Member] : aMembers)
 	{
 		bool AllowedInteractiveWithPlayers = false;
-		const int PlayerAccountID = pRes->getInt("ID");
-		const int PlayerRankID = pRes->getInt("GuildRank");
-		const int PlayerDeposit = pRes->getInt("GuildDeposit");
-		CSqlString<32> PlayerNickname(pRes->getString("Nick").c_str());
+		const int PlayerRankID = Member.m_RankID;
+		const int PlayerDeposit = Member.m_Deposit;
+		const char* pPlayerNickname = Job()->PlayerName(PlayerAccountID);
 
 		// without access
 		if(!SelfGuild)
 		{
-			GS()->AVL(ClientID, "null",  "{STR} {STR} Deposit: {VAL}", GetGuildRank(GuildID, PlayerRankID), PlayerNickname.cstr(), PlayerDeposit);
+			GS()->AVL(ClientID, "null",  "{STR} {STR} Deposit: {VAL}", GetGuildRank(GuildID, PlayerRankID), pPlayerNickname, PlayerDeposit);
 			continue;
 		}
 
 		// with access for interactives with players
-		GS()->AVH(ClientID, HideID, "{STR} {STR} Deposit: {VAL}", GetGuildRank(GuildID, PlayerRankID), PlayerNickname.cstr(), PlayerDeposit);
+		GS()->AVH(ClientID, HideID, "{STR} {STR} Deposit: {VAL}", GetGuildRank(GuildID, PlayerRankID), pPlayerNickname, PlayerDeposit);
 		if(CheckMemberAccess(pPlayer, ACCESS_LEADER))
 		{
 			for(auto& pRank : CGuildRankData::ms_aRankGuild)
@@ -1015,6 +1078,7 @@ void GuildCore::AddExperience(int GuildID)
 		GS()->ChatDiscord(DC_SERVER_INFO, "Information", "Guild {STR} raised the level up to {INT}", CGuildData::ms_aGuild[GuildID].m_aName, CGuildData::ms_aGuild[GuildID].m_Level);
 		AddHistoryGuild(GuildID, "Guild raised level to '%d'.", CGuildData::ms_aGuild[GuildID].m_Level);
 	}
+	CGuildData::UpdateRanking(GuildID);
 
 	if(random_int()%10 == 2 || UpdateTable)
 		Database->Execute<DB::UPDATE>("tw_guilds", "Level = '%d', Experience = '%d' WHERE ID = '%d'", CGuildData::ms_aGuild[GuildID].m_Level, CGuildData::ms_aGuild[GuildID].m_Exp, GuildID);
@@ -1028,6 +1092,7 @@ bool GuildCore::AddMoneyBank(int GuildID, int Money)
 
 	// add money
 	CGuildData::ms_aGuild[GuildID].m_Bank = pRes->getInt("Bank") + Money;
+	CGuildData::UpdateRanking(GuildID);
 	Database->Execute<DB::UPDATE>("tw_guilds", "Bank = '%d' WHERE ID = '%d'", CGuildData::ms_aGuild[GuildID].m_Bank, GuildID);
 	return true;
 }
@@ -1045,6 +1110,7 @@ bool GuildCore::RemoveMoneyBank(int GuildID, int Money)
 
 	// payment
 	CGuildData::ms_aGuild[GuildID].m_Bank -= Money;
+	CGuildData::UpdateRanking(GuildID);
 	Database->Execute<DB::UPDATE>("tw_guilds", "Bank = '%d' WHERE ID = '%d'", CGuildData::ms_aGuild[GuildID].m_Bank, GuildID);
 	return true;
 }
@@ -1066,6 +1132,7 @@ bool GuildCore::UpgradeGuild(int GuildID, int Field)
 
 		CGuildData::ms_aGuild[GuildID].m_UpgradeData(Field, 0).m_Value++;
 		CGuildData::ms_aGuild[GuildID].m_Bank -= PriceAvailable;
+		CGuildData::UpdateRanking(GuildID);
 		Database->Execute<DB::UPDATE>("tw_guilds", "Bank = '%d', %s = '%d' WHERE ID = '%d'", CGuildData::ms_aGuild[GuildID].m_Bank, pFieldName, CGuildData::ms_aGuild[GuildID].m_UpgradeData(Field, 0).m_Value, GuildID);
 		return true;
 	}
@@ -1116,11 +1183,13 @@ void GuildCore::AddRank(int GuildID, const char *Rank)
 	if(CGuildRankData::ms_aRankGuild.find(FindRank) != CGuildRankData::ms_aRankGuild.end())
 		return GS()->ChatGuild(GuildID, "Found this rank in your table, change name");
 
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_guilds_ranks", "WHERE GuildID = '%d'", GuildID);
-	if(pRes->rowsCount() >= 5) return;
+	const auto RanksNum = std::count_if(CGuildRankData::ms_aRankGuild.begin(), CGuildRankData::ms_aRankGuild.end(), [GuildID](const auto& Rank) { return Rank.second.m_GuildID == GuildID; });
+	if(RanksNum >= 5)
+		return;
 
-	ResultPtr pResID = Database->Execute<DB::SELECT>("ID", "tw_guilds_ranks", "ORDER BY ID DESC LIMIT 1");
-	const int InitID = pResID->next() ? pResID->getInt("ID")+1 : 1; // thread save ? hm need for table all time auto increment = 1; NEED FIX IT
+	const int InitID = CIdAllocator::Get(ID_GUILD_RANKS).Allocate();
+	if(InitID <= 0)
+		return;
 
 	CSqlString<64> cGuildRank = CSqlString<64>(Rank);
 	Database->Execute<DB::INSERT>("tw_guilds_ranks", "(ID, GuildID, Name) VALUES ('%d', '%d', '%s')", InitID, GuildID, cGuildRank.cstr());
@@ -1136,6 +1205,14 @@ void GuildCore::DeleteRank(int RankID, int GuildID)
 {
 	if(CGuildRankData::ms_aRankGuild.find(RankID) != CGuildRankData::ms_aRankGuild.end())
 	{
+		{
+			std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+			for(auto& [AccountID, Member] : CGuildData::ms_aGuild[GuildID].m_aMembers)
+			{
+				if(Member.m_RankID == RankID)
+					Member.m_RankID = 0;
+			}
+		}
 		Database->Execute<DB::UPDATE>("tw_accounts_data", "GuildRank = NULL WHERE GuildRank = '%d' AND GuildID = '%d'", RankID, GuildID);
 		Database->Execute<DB::REMOVE>("tw_guilds_ranks", "WHERE ID = '%d' AND GuildID = '%d'", RankID, GuildID);
 		GS()->ChatGuild(GuildID, "Rank [{STR}] succesful delete", CGuildRankData::ms_aRankGuild[RankID].m_aRank);
@@ -1185,6 +1262,12 @@ void GuildCore::ChangePlayerRank(int AccountID, int RankID)
 	if(pPlayer)
 		pPlayer->Acc().m_GuildRank = RankID;
 
+	{
+		std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+		const auto Iter = CGuildData::ms_aAccountGuild.find(AccountID);
+		if(Iter != CGuildData::ms_aAccountGuild.end())
+			CGuildData::ms_aGuild[Iter->second].m_aMembers[AccountID].m_RankID = RankID;
+	}
 	Database->Execute<DB::UPDATE>("tw_accounts_data", "GuildRank = '%d' WHERE ID = '%d'", RankID, AccountID);
 }
 
@@ -1224,10 +1307,9 @@ void GuildCore::ShowMenuRank(CPlayer *pPlayer)
 ######################################################################### */
 int GuildCore::GetGuildPlayerValue(int GuildID)
 {
-	int MemberPlayers = -1;
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_accounts_data", "WHERE GuildID = '%d'", GuildID);
-		MemberPlayers = pRes->rowsCount();
-	return MemberPlayers;
+	std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+	const auto Iter = CGuildData::ms_aGuild.find(GuildID);
+	return Iter != CGuildData::ms_aGuild.end() ? (int)Iter->second.m_aMembers.size() : -1;
 }
 
 /* #########################################################################
@@ -1244,11 +1326,13 @@ void GuildCore::SendInviteGuild(int GuildID, CPlayer *pPlayer)
 	}
 
 	const int UserID = pPlayer->Acc().m_UserID;
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_guilds_invites", "WHERE GuildID = '%d' AND UserID = '%d'",  GuildID, UserID);
-	if(pRes->rowsCount() >= 1)
 	{
-		GS()->Chat(ClientID, "You have already sent a request to join this guild.");
-		return;
+		std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+		if(!CGuildData::ms_aGuild[GuildID].m_aInvites.insert(UserID).second)
+		{
+			GS()->Chat(ClientID, "You have already sent a request to join this guild.");
+			return;
+		}
 	}
 
 	Database->Execute<DB::INSERT>("tw_guilds_invites", "(GuildID, UserID) VALUES ('%d', '%d')", GuildID, UserID);
@@ -1260,10 +1344,16 @@ void GuildCore::SendInviteGuild(int GuildID, CPlayer *pPlayer)
 void GuildCore::ShowInvitesGuilds(int ClientID, int GuildID)
 {
 	int HideID = NUM_TAB_MENU + CItemDescription::Data().size() + 1900;
-	ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_guilds_invites", "WHERE GuildID = '%d'", GuildID);
-	while(pRes->next())
+	std::vector<int> aSenders;
+	{
+		std::lock_guard<std::recursive_mutex> Lock(CGuildData::ms_MembersMutex);
+		const CGuildData& Guild = CGuildData::ms_aGuild[GuildID];
+		aSenders.assign(Guild.m_aInvites.begin(), Guild.m_aInvites.end());
+	}
+	Job()->PrefetchPlayerNames(aSenders);
+
+	for(const int SenderID : aSenders)
 	{
-		const int SenderID = pRes->getInt("UserID");
 		const char *PlayerName = Job()->PlayerName(SenderID);
 		GS()->AVH(ClientID, HideID, "Sender {STR} to join guilds", PlayerName);
 		{
@@ -1286,21 +1376,26 @@ void GuildCore::ShowFinderGuilds(int ClientID)
 	GS()->AVM(ClientID, "MINVITENAME", 1, NOPE, "Find guild: {STR}", pPlayer->GetTempData().m_aGuildSearchBuf);
 
 	int HideID = NUM_TAB_MENU + CItemDescription::Data().size() + 1800;
-	CSqlString<64> cGuildName = CSqlString<64>(pPlayer->GetTempData().m_aGuildSearchBuf);
-	ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_guilds", "WHERE Name LIKE '%%%s%%'", cGuildName.cstr());
-	while(pRes->next())
+	std::vector<int> aGuilds;
+	CGuildData::FindByNamePart(pPlayer->GetTempData().m_aGuildSearchBuf, aGuilds);
+
+	std::vector<int> aLeaders;
+	for(const int GuildID : aGuilds)
+		aLeaders.push_back(CGuildData::ms_aGuild[GuildID].m_UserID);
+	Job()->PrefetchPlayerNames(aLeaders);
+
+	for(const int GuildID : aGuilds)
 	{
-		const int GuildID = pRes->getInt("ID");
-		const int AvailableSlot = pRes->getInt("AvailableSlots");
+		const int AvailableSlot = CGuildData::ms_aGuild[GuildID].m_UpgradeData(CGuildData::AVAILABLE_SLOTS, 0).m_Value;
 		const int PlayersCount = GetGuildPlayerValue(GuildID);
-		cGuildName = pRes->getString("Name").c_str();
+		const char* pGuildName = CGuildData::ms_aGuild[GuildID].m_aName;
 		GS()->AVH(ClientID, HideID, "{STR} : Leader {STR} : Players [{INT}/{INT}]",
-			cGuildName.cstr(), Job()->PlayerName(CGuildData::ms_aGuild[GuildID].m_UserID), PlayersCount, AvailableSlot);
+			pGuildName, Job()->PlayerName(CGuildData::ms_aGuild[GuildID].m_UserID), PlayersCount, AvailableSlot);
 		GS()->AVM(ClientID, "null", NOPE, HideID, "House: {STR} | Bank: {VAL} gold", (GetGuildHouseID(GuildID) <= 0 ? "No" : "Yes"), CGuildData::ms_aGuild[GuildID].m_Bank);
 
 		GS()->AVD(ClientID, "MENU", MENU_GUILD_FINDER_VIEW_PLAYERS, GuildID, HideID, "View player list");
 
-		GS()->AVM(ClientID, "MINVITESEND", GuildID, HideID, "Send request to join {STR}", cGuildName.cstr());
+		GS()->AVM(ClientID, "MINVITESEND", GuildID, HideID, "Send request to join {STR}", pGuildName);
 		HideID++;
 	}
 	GS()->AddVotesBackpage(ClientID);
@@ -1419,6 +1514,7 @@ void GuildCore::BuyGuildHouse(int GuildID, int HouseID)
 			return;
 		}
 		CGuildData::ms_aGuild[GuildID].m_Bank -= Price;
+		CGuildData::UpdateRanking(GuildID);
 		Database->Execute<DB::UPDATE>("tw_guilds", "Bank = '%d' WHERE ID = '%d'", CGuildData::ms_aGuild[GuildID].m_Bank, GuildID);
 
 		CGuildHouseData::ms_aHouseGuild[HouseID].m_GuildID = GuildID;
@@ -13,6 +13,10 @@ class GuildCore : public MmoComponent
 	~GuildCore() override
 	{
 		CGuildData::ms_aGuild.clear();
+		CGuildData::ms_aAccountGuild.clear();
+		CGuildData::ms_aNameIndex.clear();
+		CGuildData::ms_LevelRanking.Clear();
+		CGuildData::ms_BankRanking.Clear();
 		CGuildHouseData::ms_aHouseGuild.clear();
 		CGuildRankData::ms_aRankGuild.clear();
 	};
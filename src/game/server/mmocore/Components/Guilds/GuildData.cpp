@@ -4,4 +4,95 @@
 
 std::map < int, CGuildData > CGuildData::ms_aGuild;
 std::map < int, CGuildHouseData > CGuildHouseData::ms_aHouseGuild;
-std::map < int, CGuildRankData > CGuildRankData::ms_aRankGuild;
\ No newline at end of file
+std::map < int, CGuildRankData > CGuildRankData::ms_aRankGuild;
+
+CLeaderboard CGuildData::ms_LevelRanking;
+CLeaderboard CGuildData::ms_BankRanking;
+
+std::recursive_mutex CGuildData::ms_MembersMutex;
+std::map < int, int > CGuildData::ms_aAccountGuild;
+std::map < std::string, int > CGuildData::ms_aNameIndex;
+
+static std::string LowerName(const char* pName)
+{
+	std::string Name(pName);
+	for(char& c : Name)
+		c = (char)tolower((unsigned char)c);
+	return Name;
+}
+
+void CGuildData::UpdateRanking(int GuildID)
+{
+	const CGuildData& Guild = ms_aGuild[GuildID];
+	ms_LevelRanking.Set(GuildID, ((int64)Guild.m_Level << 32) | (unsigned)Guild.m_Exp);
+	ms_BankRanking.Set(GuildID, Guild.m_Bank);
+}
+
+void CGuildData::RemoveRanking(int GuildID)
+{
+	ms_LevelRanking.Remove(GuildID);
+	ms_BankRanking.Remove(GuildID);
+}
+
+void CGuildData::AddMember(int GuildID, int AccountID, int RankID, int Deposit)
+{
+	std::lock_guard<std::recursive_mutex> Lock(ms_MembersMutex);
+	RemoveMember(AccountID);
+	ms_aGuild[GuildID].m_aMembers[AccountID] = { RankID, Deposit };
+	ms_aAccountGuild[AccountID] = GuildID;
+}
+
+void CGuildData::RemoveMember(int AccountID)
+{
+	std::lock_guard<std::recursive_mutex> Lock(ms_MembersMutex);
+	const auto Iter = ms_aAccountGuild.find(AccountID);
+	if(Iter == ms_aAccountGuild.end())
+		return;
+
+	const auto pGuild = ms_aGuild.find(Iter->second);
+	if(pGuild != ms_aGuild.end())
+		pGuild->second.m_aMembers.erase(AccountID);
+	ms_aAccountGuild.erase(Iter);
+}
+
+void CGuildData::IndexName(int GuildID)
+{
+	std::lock_guard<std::recursive_mutex> Lock(ms_MembersMutex);
+	ms_aNameIndex[LowerName(ms_aGuild[GuildID].m_aName)] = GuildID;
+}
+
+void CGuildData::UnindexName(int GuildID)
+{
+	std::lock_guard<std::recursive_mutex> Lock(ms_MembersMutex);
+	const auto Iter = ms_aNameIndex.find(LowerName(ms_aGuild[GuildID].m_aName));
+	if(Iter != ms_aNameIndex.end() && Iter->second == GuildID)
+		ms_aNameIndex.erase(Iter);
+}
+
+int CGuildData::FindByName(const char* pName)
+{
+	std::lock_guard<std::recursive_mutex> Lock(ms_MembersMutex);
+	const auto Iter = ms_aNameIndex.find(LowerName(pName));
+	return Iter != ms_aNameIndex.end() ? Iter->second : -1;
+}
+
+void CGuildData::FindByNamePart(const char* pPart, std::vector< int >& aGuilds)
+{
+	std::lock_guard<std::recursive_mutex> Lock(ms_MembersMutex);
+	const std::string Part = LowerName(pPart);
+	aGuilds.clear();
+
+	// names starting with the text first, they are one range of the index
+	auto Iter = ms_aNameIndex.lower_bound(Part);
+	for(; Iter != ms_aNameIndex.end() && Iter->first.compare(0, Part.size(), Part) == 0; ++Iter)
+		aGuilds.push_back(Iter->second);
+
+	if(Part.empty())
+		return;
+
+	for(const auto& [Name, GuildID] : ms_aNameIndex)
+	{
+		if(Name.find(Part) != std::string::npos && Name.compare(0, Part.size(), Part) != 0)
+			aGuilds.push_back(GuildID);
+	}
+}
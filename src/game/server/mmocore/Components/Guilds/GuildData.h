@@ -4,6 +4,16 @@
 #define GAME_SERVER_COMPONENT_GUILD_DATA_H
 
 #include <game/server/mmocore/Utils/FieldData.h>
+#include <game/server/mmocore/Utils/Leaderboard.h>
+
+#include <mutex>
+#include <set>
+
+struct CGuildMemberData
+{
+	int m_RankID;
+	int m_Deposit;
+};
 
 struct CGuildData
 {
@@ -27,7 +37,30 @@ struct CGuildData
 	int m_Bank;
 	int m_Score;
 
+	// members by account id and the accounts that asked to join, written through to the database
+	std::map< int, CGuildMemberData > m_aMembers;
+	std::set< int > m_aInvites;
+
 	static std::map< int, CGuildData > ms_aGuild;
+
+	// members and invites are read by the vote jobs, lock this around any access
+	static std::recursive_mutex ms_MembersMutex;
+	static std::map< int, int > ms_aAccountGuild;
+	static void AddMember(int GuildID, int AccountID, int RankID = 0, int Deposit = 0);
+	static void RemoveMember(int AccountID);
+
+	// lowercase name to guild id, used for the name checks and the finder
+	static std::map< std::string, int > ms_aNameIndex;
+	static void IndexName(int GuildID);
+	static void UnindexName(int GuildID);
+	static int FindByName(const char* pName);
+	static void FindByNamePart(const char* pPart, std::vector< int >& aGuilds);
+
+	// rankings for the top list, kept in sync with ms_aGuild
+	static CLeaderboard ms_LevelRanking;
+	static CLeaderboard ms_BankRanking;
+	static void UpdateRanking(int GuildID);
+	static void RemoveRanking(int GuildID);
 };
 
 struct CGuildHouseData
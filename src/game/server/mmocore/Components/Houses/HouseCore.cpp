@@ -4,6 +4,7 @@
 
 #include <engine/shared/config.h>
 #include <game/server/gamecontext.h>
+#include <game/server/mmocore/Utils/IdAllocator.h>
 
 #include <game/server/mmocore/GameEntities/decoration_houses.h>
 #include <game/server/mmocore/GameEntities/jobitems.h>
@@ -13,6 +14,8 @@
 
 void CHouseCore::OnInitWorld(const char* pWhereLocalWorld)
 {
+	CIdAllocator::Get(ID_HOUSE_DECORATIONS).Prefetch();
+
 	// load house
 	auto InitHouses = Database->Prepare<DB::SELECT>("*", "tw_houses", pWhereLocalWorld);
 	InitHouses->AtExecute([this](ResultPtr pRes)
@@ -347,14 +350,17 @@ bool CHouseCore::AddDecorationHouse(int DecoID, int HouseID, vec2 Position)
 		return false;
 	}
 
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_houses_decorations", "WHERE HouseID = '%d'", HouseID);
-	if(static_cast<int>(pRes->rowsCount()) >= g_Config.m_SvLimitDecoration)
+	const auto DecorationsNum = std::count_if(m_aDecorationHouse.begin(), m_aDecorationHouse.end(), [HouseID](const auto& Decoration) { return Decoration.second->m_HouseID == HouseID; });
+	if(static_cast<int>(DecorationsNum) >= g_Config.m_SvLimitDecoration)
 	{
 		return false;
 	}
 
-	ResultPtr pRes2 = Database->Execute<DB::SELECT>("ID", "tw_houses_decorations", "ORDER BY ID DESC LIMIT 1");
-	const int InitID = pRes2->next() ? pRes2->getInt("ID")+1 : 1;
+	const int InitID = CIdAllocator::Get(ID_HOUSE_DECORATIONS).Allocate();
+	if(InitID <= 0)
+	{
+		return false;
+	}
 
 	Database->Execute<DB::INSERT>("tw_houses_decorations", "(ID, DecoID, HouseID, PosX, PosY, WorldID) VALUES ('%d', '%d', '%d', '%d', '%d', '%d')",
 		InitID, DecoID, HouseID, static_cast<int>(Position.x), static_cast<int>(Position.y), GS()->GetWorldID());
@@ -9,7 +9,7 @@
 #include <game/server/mmocore/Components/Quests/QuestCore.h>
 
 template < typename T >
-bool ExecuteTemplateItemsTypes(T Type, std::map < int, CPlayerItem >& paItems, const std::function<void(const CPlayerItem&)> pFunc)
+bool ExecuteTemplateItemsTypes(T Type, CFlatStableMap < int, CPlayerItem >& paItems, const std::function<void(const CPlayerItem&)> pFunc)
 {
 	bool Found = false;
 	for(const auto& [ItemID, ItemData] : paItems)
@@ -302,6 +302,7 @@ int CInventoryCore::GiveItem(CPlayer *pPlayer, ItemIdentifier ItemID, int Value,
 {
 	const int ClientID = pPlayer->GetCID();
 	const int SecureID = SecureCheck(pPlayer, ItemID, Value, Settings, Enchant);
+	pPlayer->InvalidateAttributes();
 	if(SecureID == 1)
 	{
 		Database->Execute<DB::UPDATE>("tw_accounts_items", "Value = '%d', Settings = '%d', Enchant = '%d' WHERE ItemID = '%d' AND UserID = '%d'",
@@ -336,6 +337,7 @@ int CInventoryCore::SecureCheck(CPlayer *pPlayer, ItemIdentifier ItemID, int Val
 int CInventoryCore::RemoveItem(CPlayer *pPlayer, ItemIdentifier ItemID, int Value, int Settings)
 {
 	const int SecureID = DeSecureCheck(pPlayer, ItemID, Value, Settings);
+	pPlayer->InvalidateAttributes();
 	if(SecureID == 1)
 	{
 		Database->Execute<DB::UPDATE>("tw_accounts_items", "Value = Value - '%d', Settings = Settings - '%d' WHERE ItemID = '%d' AND UserID = '%d'",
@@ -20,6 +20,17 @@ CPlayer* CPlayerItem::GetPlayer() const
 	return nullptr;
 }
 
+void CPlayerItem::Init(int Value, int Enchant, int Durability, int Settings)
+{
+	m_Value = Value;
+	m_Enchant = Enchant;
+	m_Durability = Durability;
+	m_Settings = Settings;
+	CPlayerItem::m_pData[m_ClientID][m_ID] = *this;
+	if(GetPlayer())
+		GetPlayer()->InvalidateAttributes();
+}
+
 inline int randomRangecount(int startrandom, int endrandom, int count)
 {
 	int result = 0;
@@ -37,6 +48,7 @@ bool CPlayerItem::SetEnchant(int Enchant)
 		return false;
 
 	m_Enchant = Enchant;
+	GetPlayer()->InvalidateAttributes();
 	return Save();
 }
 
@@ -46,6 +58,7 @@ bool CPlayerItem::SetSettings(int Settings)
 		return false;
 
 	m_Settings = Settings;
+	GetPlayer()->InvalidateAttributes();
 	return Save();
 }
 
@@ -127,6 +140,7 @@ bool CPlayerItem::Equip()
 		return false;
 
 	m_Settings ^= true;
+	GetPlayer()->InvalidateAttributes();
 
 	if(Info()->IsType(ItemType::TYPE_EQUIP))
 	{
@@ -157,7 +171,7 @@ bool CPlayerItem::Use(int Value)
 	// potion mana regen
 	if(m_ID == itPotionManaRegen && Remove(Value, 0))
 	{
-		GetPlayer()->GiveEffect("RegenMana", 15);
+		GetPlayer()->GiveEffect(EFFECT_REGEN_MANA, 15);
 		GS()->Chat(ClientID, "You used {STR}x{VAL}", Info()->GetName(), Value);
 		return true;
 	}
@@ -207,6 +221,7 @@ bool CPlayerItem::Use(int Value)
 				GetPlayer()->Acc().m_aStats[ID] = 0;
 			}
 		}
+		GetPlayer()->InvalidateAttributes();
 
 		GS()->Chat(-1, "{STR} used {STR} returned {INT} upgrades.", GS()->Server()->ClientName(ClientID), Info()->GetName(), BackUpgrades);
 		GetPlayer()->Acc().m_Upgrade += BackUpgrades;
@@ -238,6 +253,7 @@ bool CPlayerItem::Use(int Value)
 				GetPlayer()->Acc().m_aStats[ID] -= UpgradeValue;
 			}
 		}
+		GetPlayer()->InvalidateAttributes();
 
 		GS()->Chat(-1, "{STR} used {STR} returned {INT} upgrades.", GS()->Server()->ClientName(ClientID), Info()->GetName(), BackUpgrades);
 		GetPlayer()->Acc().m_Upgrade += BackUpgrades;
@@ -260,7 +276,7 @@ bool CPlayerItem::Use(int Value)
 		if(Remove(Value, 0))
 		{
 			int PotionTime = pHeal->getTime();
-			GetPlayer()->GiveEffect(pHeal->getEffect(), PotionTime);
+			GetPlayer()->GiveEffect(pHeal->getEffectID(), PotionTime);
 			GetPlayer()->m_aPlayerTick[PotionRecast] = Server()->Tick() + ((PotionTime + POTION_RECAST_APPEND_TIME) * Server()->TickSpeed());
 
 			GS()->Chat(ClientID, "You used {STR}x{VAL}", Info()->GetName(), Value);
@@ -299,6 +315,8 @@ bool CPlayerItem::Save() const
 	{
 		Database->Execute<DB::UPDATE>("tw_accounts_items", "Value = '%d', Settings = '%d', Enchant = '%d', Durability = '%d' WHERE UserID = '%d' AND ItemID = '%d'",
 			m_Value, m_Settings, m_Enchant, m_Durability, GetPlayer()->Acc().m_UserID, m_ID);
+		if(m_ID == itGold)
+			CAccountRankingData::ms_Gold.Set(GetPlayer()->Acc().m_UserID, m_Value);
 		return true;
 	}
 	return false;
@@ -5,6 +5,8 @@
 
 #include "ItemInfoData.h"
 
+#include <game/server/mmocore/Utils/ClientDataStorage.h>
+
 class CItem;
 using CItemsContainer = std::deque<CItem>;
 
@@ -43,7 +45,7 @@ public:
 	[[nodiscard]] static CItemsContainer FromArrayJSON(const std::string& json);
 };
 
-class CPlayerItem : public CItem, public MultiworldIdentifiableStaticData< std::map < int, std::map < int, CPlayerItem > > >
+class CPlayerItem : public CItem, public MultiworldIdentifiableStaticData< CClientFlatStorage < int, CPlayerItem > >
 {
 	friend class CInventoryCore;
 	int m_ClientID{};
@@ -55,14 +57,7 @@ public:
 	CPlayerItem() = default;
 	CPlayerItem(ItemIdentifier ID, int ClientID) : m_ClientID(ClientID) { m_ID = ID; }
 	
-	void Init(int Value, int Enchant, int Durability, int Settings)
-	{
-		m_Value = Value;
-		m_Enchant = Enchant;
-		m_Durability = Durability;
-		m_Settings = Settings;
-		CPlayerItem::m_pData[m_ClientID][m_ID] = *this;
-	}
+	void Init(int Value, int Enchant, int Durability, int Settings);
 	
 	// getters
 	int GetEnchantStats(AttributeIdentifier ID) const { return Info()->GetInfoEnchantStats(ID, m_Enchant); }
@@ -87,7 +87,7 @@ void CItemDescription::StrFormatAttributes(CPlayer* pPlayer, char* pBuffer, int
 		if(Att.HasValue())
 		{
 			const int BonusValue = GetInfoEnchantStats(Att.GetID(), Enchant);
-			pPlayer->GS()->Server()->Localization()->Format(Buffer, pPlayer->GetLanguage(), "{STR}+{VAL} ", Att.Info()->GetName(), BonusValue);
+			pPlayer->GS()->Server()->Localization()->Format(Buffer, pPlayer->GetLanguageInfo(), "{STR}+{VAL} ", Att.Info()->GetName(), BonusValue);
 		}
 	}
 	str_copy(pBuffer, Buffer.buffer(), Size);
@@ -2,10 +2,14 @@
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "QuestCore.h"
 
+#include <engine/shared/config.h>
 #include <game/server/gamecontext.h>
 
 void QuestCore::OnInit()
 {
+	// databases created before the step progress moved out of the json files
+	Database->ExecuteSync("ALTER TABLE tw_accounts_quests ADD COLUMN IF NOT EXISTS StepsData varchar(1024) NOT NULL DEFAULT ''");
+
 	ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_quests_list");
 	while(pRes->next())
 	{
@@ -27,15 +31,24 @@ void QuestCore::OnInitAccount(CPlayer* pPlayer)
 		const int QuestID = pRes->getInt("QuestID");
 		CQuestData::ms_aPlayerQuests[ClientID][QuestID].m_pPlayer = pPlayer;
 		CQuestData::ms_aPlayerQuests[ClientID][QuestID].m_QuestID = QuestID;
+		CQuestData::ms_aPlayerQuests[ClientID][QuestID].m_AccountID = pPlayer->Acc().m_UserID;
 		CQuestData::ms_aPlayerQuests[ClientID][QuestID].m_State = (QuestState)pRes->getInt("Type");
-		CQuestData::ms_aPlayerQuests[ClientID][QuestID].LoadSteps();
+		CQuestData::ms_aPlayerQuests[ClientID][QuestID].LoadSteps(pRes->getString("StepsData").c_str());
 	}
 }
 
+void QuestCore::OnTick()
+{
+	// step progress is written in batches, the players are shared between all worlds
+	if(GS()->GetWorldID() == MAIN_WORLD_ID && Server()->Tick() % (Server()->TickSpeed() * g_Config.m_SvQuestSaveInterval) == 0)
+		CQuestData::FlushAllSteps();
+}
+
 void QuestCore::OnResetClient(int ClientID)
 {
 	for(auto& qp : CQuestData::ms_aPlayerQuests[ClientID])
 	{
+		qp.second.FlushSteps();
 		for(auto& pStepBot : qp.second.m_StepsQuestBot)
 		{
 			pStepBot.second.m_ClientQuitting = true;
@@ -23,6 +23,7 @@ class QuestCore : public MmoComponent
 
 	void OnInit() override;
 	void OnInitAccount(CPlayer* pPlayer) override;
+	void OnTick() override;
 	void OnResetClient(int ClientID) override;
 	bool OnHandleMenulist(CPlayer* pPlayer, int Menulist, bool ReplaceMenu) override;
 	bool OnHandleVoteCommands(CPlayer* pPlayer, const char* CMD, int VoteID, int VoteID2, int Get, const char* GetText) override;
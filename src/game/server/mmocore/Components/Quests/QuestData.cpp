@@ -10,24 +10,15 @@
 CQuestDataInfo& CQuestData::Info() const { return CQuestDataInfo::ms_aDataQuests[m_QuestID]; }
 std::string CQuestData::GetJsonFileName() const { return Info().GetJsonFileName(m_pPlayer->Acc().m_UserID); }
 
-std::map < int, std::map <int, CQuestData > > CQuestData::ms_aPlayerQuests;
+CClientFlatStorage < int, CQuestData > CQuestData::ms_aPlayerQuests;
 void CQuestData::InitSteps()
 {
 	if(m_State != QuestState::ACCEPT || !m_pPlayer)
 		return;
 
-	// checking dir
-	if(!fs_is_dir("server_data/quest_tmp"))
-	{
-		fs_makedir("server_data");
-		fs_makedir("server_data/quest_tmp");
-	}
-
 	// initialized quest steps
 	m_Step = 1;
 	m_StepsQuestBot = Info().CopyBasicSteps();
-	nlohmann::json JsonQuestData;
-	JsonQuestData["current_step"] = m_Step;
 	for(auto& pStep : m_StepsQuestBot)
 	{
 		pStep.second.m_MobProgress[0] = 0;
@@ -36,92 +27,148 @@ void CQuestData::InitSteps()
 		pStep.second.m_ClientQuitting = false;
 		pStep.second.UpdateBot();
 		pStep.second.CreateStepArrow(m_pPlayer->GetCID());
-
-		JsonQuestData["steps"].push_back(
-		{
-			{ "subbotid", pStep.second.m_Bot.m_SubBotID },
-			{ "mobprogress1", pStep.second.m_MobProgress[0] },
-			{ "mobprogress2", pStep.second.m_MobProgress[1] },
-			{ "state", pStep.second.m_StepComplete }
-		});
 	}
+	m_StepsDirty = true;
+}
 
-	// save file
-	IOHANDLE File = io_open(GetJsonFileName().c_str(), IOFLAG_WRITE);
-	if(!File)
-		return;
+// "step;subbot:mob1:mob2:complete;..." only the steps that have progress are written
+void CQuestData::FormatSteps(char* pBuffer, int BufferSize) const
+{
+	int Length = str_format(pBuffer, BufferSize, "%d", m_Step);
+	for(const auto& pStep : m_StepsQuestBot)
+	{
+		const CPlayerQuestStepDataInfo& Step = pStep.second;
+		if(!Step.m_StepComplete && !Step.m_MobProgress[0] && !Step.m_MobProgress[1])
+			continue;
 
-	std::string Data = JsonQuestData.dump();
-	io_write(File, Data.c_str(), Data.length());
-	io_close(File);
+		char aStep[64];
+		const int StepLength = str_format(aStep, sizeof(aStep), ";%d:%d:%d:%d", pStep.first, Step.m_MobProgress[0], Step.m_MobProgress[1], (int)Step.m_StepComplete);
+		if(Length + StepLength >= BufferSize)
+		{
+			dbg_msg("quest", "steps of quest %d don't fit into %d bytes", m_QuestID, BufferSize);
+			break;
+		}
+		str_copy(pBuffer + Length, aStep, BufferSize - Length);
+		Length += StepLength;
+	}
 }
 
-void CQuestData::LoadSteps()
+void CQuestData::LoadSteps(const char* pStepsData)
 {
 	if(m_State != QuestState::ACCEPT || !m_pPlayer)
 		return;
 
-	// loading file is not open pereinitilized steps
-	IOHANDLE File = io_open(GetJsonFileName().c_str(), IOFLAG_READ);
-	if(!File)
+	// progress from before the column existed is imported once, otherwise it's a fresh start
+	if(!pStepsData || !pStepsData[0])
 	{
-		InitSteps();
+		if(!ImportJsonSteps())
+			InitSteps();
 		return;
 	}
 
-	const int FileSize = (int)io_length(File) + 1;
-	char* pFileData = (char*)malloc(FileSize);
-	mem_zero(pFileData, FileSize);
-	io_read(File, pFileData, FileSize);
+	m_StepsQuestBot = Info().CopyBasicSteps();
+	for(auto& pStep : m_StepsQuestBot)
+	{
+		pStep.second.m_MobProgress[0] = 0;
+		pStep.second.m_MobProgress[1] = 0;
+		pStep.second.m_StepComplete = false;
+	}
 
-	// close and clear
-	nlohmann::json JsonQuestData = nlohmann::json::parse(pFileData);
-	mem_free(pFileData);
-	io_close(File);
+	char* pEnd = nullptr;
+	m_Step = max(1, (int)strtol(pStepsData, &pEnd, 10));
+	while(*pEnd == ';')
+	{
+		int aValues[4] = {};
+		for(int i = 0; i < 4; i++)
+		{
+			aValues[i] = (int)strtol(pEnd + 1, &pEnd, 10);
+			if(*pEnd != ':')
+				break;
+		}
+
+		const auto Iter = m_StepsQuestBot.find(aValues[0]);
+		if(Iter == m_StepsQuestBot.end())
+			continue;
+
+		Iter->second.m_MobProgress[0] = aValues[1];
+		Iter->second.m_MobProgress[1] = aValues[2];
+		Iter->second.m_StepComplete = aValues[3] != 0;
+	}
 
-	// loading steps
-	m_StepsQuestBot = Info().CopyBasicSteps();
-	m_Step = JsonQuestData.value("current_step", 1);
-	auto Steps = JsonQuestData["steps"];
-	for(auto& pStep : Steps)
+	for(auto& pStep : m_StepsQuestBot)
 	{
-		const int SubBotID = pStep.value("subbotid", 0);
-		m_StepsQuestBot[SubBotID].m_StepComplete = pStep.value("state", false);
-		m_StepsQuestBot[SubBotID].m_MobProgress[0] = pStep.value("mobprogress1", 0);
-		m_StepsQuestBot[SubBotID].m_MobProgress[1] = pStep.value("mobprogress2", 0);
-		m_StepsQuestBot[SubBotID].m_ClientQuitting = false;
-		m_StepsQuestBot[SubBotID].UpdateBot();
-		m_StepsQuestBot[SubBotID].CreateStepArrow(m_pPlayer->GetCID());
+		pStep.second.m_ClientQuitting = false;
+		pStep.second.UpdateBot();
+		pStep.second.CreateStepArrow(m_pPlayer->GetCID());
 	}
+	m_StepsDirty = false;
 }
 
-void CQuestData::SaveSteps()
+bool CQuestData::ImportJsonSteps()
 {
-	if(m_State != QuestState::ACCEPT)
-		return;
+	const std::string FileName = GetJsonFileName();
+	IOHANDLE File = io_open(FileName.c_str(), IOFLAG_READ);
+	if(!File)
+		return false;
 
-	// set json structure
-	nlohmann::json JsonQuestData;
-	JsonQuestData["current_step"] = m_Step;
-	for(auto& pStep : m_StepsQuestBot)
+	const int FileSize = (int)io_length(File);
+	std::string Data(FileSize, '\0');
+	io_read(File, &Data[0], FileSize);
+	io_close(File);
+
+	bool Imported = false;
+	JsonTools::parseFromString(Data, [&](nlohmann::json& JsonQuestData)
 	{
-		JsonQuestData["steps"].push_back(
+		m_StepsQuestBot = Info().CopyBasicSteps();
+		m_Step = JsonQuestData.value("current_step", 1);
+		for(auto& pStep : JsonQuestData["steps"])
 		{
-			{ "subbotid", pStep.second.m_Bot.m_SubBotID },
-			{ "mobprogress1", pStep.second.m_MobProgress[0] },
-			{ "mobprogress2", pStep.second.m_MobProgress[1] },
-			{ "state", pStep.second.m_StepComplete }
-		});
+			const int SubBotID = pStep.value("subbotid", 0);
+			m_StepsQuestBot[SubBotID].m_StepComplete = pStep.value("state", false);
+			m_StepsQuestBot[SubBotID].m_MobProgress[0] = pStep.value("mobprogress1", 0);
+			m_StepsQuestBot[SubBotID].m_MobProgress[1] = pStep.value("mobprogress2", 0);
+		}
+		Imported = true;
+	});
+	if(!Imported)
+		return false;
+
+	for(auto& pStep : m_StepsQuestBot)
+	{
+		pStep.second.m_ClientQuitting = false;
+		pStep.second.UpdateBot();
+		pStep.second.CreateStepArrow(m_pPlayer->GetCID());
 	}
 
-	// replace file
-	IOHANDLE File = io_open(GetJsonFileName().c_str(), IOFLAG_WRITE);
-	if(!File)
+	// the legacy file is kept until the progress is stored in the database
+	char aStepsData[1024];
+	FormatSteps(aStepsData, sizeof(aStepsData));
+	m_StepsDirty = false;
+	Database->Prepare<DB::UPDATE>("tw_accounts_quests", "StepsData = '%s' WHERE QuestID = '%d' AND UserID = '%d'", aStepsData, m_QuestID, m_AccountID)->AtExecute([FileName]()
+	{
+		fs_remove(FileName.c_str());
+	});
+	return true;
+}
+
+void CQuestData::FlushSteps()
+{
+	if(!m_StepsDirty || m_State != QuestState::ACCEPT || m_AccountID <= 0)
 		return;
 
-	std::string Data = JsonQuestData.dump();
-	io_write(File, Data.c_str(), Data.length());
-	io_close(File);
+	char aStepsData[1024];
+	FormatSteps(aStepsData, sizeof(aStepsData));
+	Database->Execute<DB::UPDATE>("tw_accounts_quests", "StepsData = '%s' WHERE QuestID = '%d' AND UserID = '%d'", aStepsData, m_QuestID, m_AccountID);
+	m_StepsDirty = false;
+}
+
+void CQuestData::FlushAllSteps()
+{
+	for(int ClientID = 0; ClientID < MAX_CLIENTS; ClientID++)
+	{
+		for(auto& pQuest : ms_aPlayerQuests[ClientID])
+			pQuest.second.FlushSteps();
+	}
 }
 
 void CQuestData::ClearSteps()
@@ -133,7 +180,7 @@ void CQuestData::ClearSteps()
 	}
 
 	m_StepsQuestBot.clear();
-	fs_remove(GetJsonFileName().c_str());
+	m_StepsDirty = false;
 }
 
 bool CQuestData::Accept()
@@ -144,13 +191,16 @@ bool CQuestData::Accept()
 	int ClientID = m_pPlayer->GetCID();
 	CGS* pGS = (CGS*)Instance::GetServer()->GameServerPlayer(ClientID);
 
-	// init quest
+	// init quest and steps
 	m_State = QuestState::ACCEPT;
-	Database->Execute<DB::INSERT>("tw_accounts_quests", "(QuestID, UserID, Type) VALUES ('%d', '%d', '%d')", m_QuestID, m_pPlayer->Acc().m_UserID, m_State);
-
-	// init steps
+	m_AccountID = m_pPlayer->Acc().m_UserID;
 	InitSteps();
 
+	char aStepsData[1024];
+	FormatSteps(aStepsData, sizeof(aStepsData));
+	Database->Execute<DB::INSERT>("tw_accounts_quests", "(QuestID, UserID, Type, StepsData) VALUES ('%d', '%d', '%d', '%s')", m_QuestID, m_AccountID, m_State, aStepsData);
+	m_StepsDirty = false;
+
 	// information
 	const int QuestsSize = Info().GetQuestStorySize();
 	const int QuestPosition = Info().GetQuestStoryPosition();
@@ -171,7 +221,7 @@ void CQuestData::Finish()
 
 	// finish quest
 	m_State = QuestState::FINISHED;
-	Database->Execute<DB::UPDATE>("tw_accounts_quests", "Type = '%d' WHERE QuestID = '%d' AND UserID = '%d'", m_State, m_QuestID, m_pPlayer->Acc().m_UserID);
+	Database->Execute<DB::UPDATE>("tw_accounts_quests", "Type = '%d', StepsData = '' WHERE QuestID = '%d' AND UserID = '%d'", m_State, m_QuestID, m_pPlayer->Acc().m_UserID);
 
 	// clear steps
 	ClearSteps();
@@ -4,24 +4,29 @@
 #define GAME_SERVER_COMPONENT_QUEST_DATA_H
 #include "QuestDataInfo.h"
 
+#include <game/server/mmocore/Utils/ClientDataStorage.h>
+
 class CQuestData
 {
 public:
 	int m_QuestID;
+	int m_AccountID;
 	CPlayer* m_pPlayer;
 
 	QuestState m_State;
 	int m_Step;
+	bool m_StepsDirty;
 
 	std::string GetJsonFileName() const;
 	CQuestDataInfo& Info() const;
 	bool IsComplected() const { return m_State == QuestState::FINISHED; }
 	QuestState GetState() const { return m_State; }
 
-	// steps
+	// steps, kept in memory and written to tw_accounts_quests.StepsData by FlushSteps
 	void InitSteps();
-	void LoadSteps();
-	void SaveSteps();
+	void LoadSteps(const char* pStepsData);
+	void SaveSteps() { m_StepsDirty = true; }
+	void FlushSteps();
 	void ClearSteps();
 	std::map < int, CPlayerQuestStepDataInfo > m_StepsQuestBot;
 
@@ -30,9 +35,12 @@ public:
 	bool Accept();
 private:
 	void Finish();
+	void FormatSteps(char* pBuffer, int BufferSize) const;
+	bool ImportJsonSteps();
 
 public:
-	static std::map < int, std::map <int, CQuestData > > ms_aPlayerQuests;
+	static CClientFlatStorage < int, CQuestData > ms_aPlayerQuests;
+	static void FlushAllSteps();
 };
 
 #endif
\ No newline at end of file
@@ -274,7 +274,7 @@ void CPlayerQuestStepDataInfo::ShowRequired(CPlayer* pPlayer, const char* pBuffe
 		if(BotID > 0 && ValueMob > 0 && DataBotInfo::ms_aDataBot.find(BotID) != DataBotInfo::ms_aDataBot.end())
 		{
 			Buffer.append_at(Buffer.length(), "\n");
-			pGS->Server()->Localization()->Format(Buffer, pPlayer->GetLanguage(), "- Defeat {STR} ({INT}/{INT})", DataBotInfo::ms_aDataBot[BotID].m_aNameBot, m_MobProgress[i], ValueMob);
+			pGS->Server()->Localization()->Format(Buffer, pPlayer->GetLanguageInfo(), "- Defeat {STR} ({INT}/{INT})", DataBotInfo::ms_aDataBot[BotID].m_aNameBot, m_MobProgress[i], ValueMob);
 			IsActiveTask = true;
 		}
 
@@ -286,8 +286,8 @@ void CPlayerQuestStepDataInfo::ShowRequired(CPlayer* pPlayer, const char* pBuffe
 			Buffer.append_at(Buffer.length(), "\n");
 
 			const char* pInteractiveType = m_Bot.m_InteractiveType == (int)INTERACTIVE_SHOW_ITEMS ? "Show" : "Need";
-			pGS->Server()->Localization()->Format(Buffer, pPlayer->GetLanguage(), "- {STR} {STR} ({VAL}/{VAL})", 
-				pGS->Server()->Localization()->Localize(pPlayer->GetLanguage(), pInteractiveType), pPlayerItem->Info()->GetName(), pPlayerItem->GetValue(), ValueItem);
+			pGS->Server()->Localization()->Format(Buffer, pPlayer->GetLanguageInfo(), "- {STR} {STR} ({VAL}/{VAL})", 
+				pGS->Server()->Localization()->Localize(pPlayer->GetLanguageInfo(), pInteractiveType), pPlayerItem->Info()->GetName(), pPlayerItem->GetValue(), ValueItem);
 
 			IsActiveTask = true;
 		}
@@ -301,7 +301,7 @@ void CPlayerQuestStepDataInfo::ShowRequired(CPlayer* pPlayer, const char* pBuffe
 		if(ItemID > 0 && ValueItem > 0)
 		{
 			Buffer.append_at(Buffer.length(), "\n");
-			pGS->Server()->Localization()->Format(Buffer, pPlayer->GetLanguage(), "- Receive {STR} ({VAL})", pPlayer->GetItem(ItemID)->Info()->GetName(), ValueItem);
+			pGS->Server()->Localization()->Format(Buffer, pPlayer->GetLanguageInfo(), "- Receive {STR} ({VAL})", pPlayer->GetItem(ItemID)->Info()->GetName(), ValueItem);
 		}
 	}
 
@@ -5,7 +5,9 @@
 
 #include "SkillDataInfo.h"
 
-class CSkill : public MultiworldIdentifiableStaticData< std::map< int, std::map < int, CSkill > > >
+#include <game/server/mmocore/Utils/ClientDataStorage.h>
+
+class CSkill : public MultiworldIdentifiableStaticData< CClientFlatStorage < int, CSkill > >
 {
 	friend class CSkillsCore;
 
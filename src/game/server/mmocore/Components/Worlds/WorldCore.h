@@ -12,7 +12,7 @@ class CWorldDataCore : public MmoComponent
 	~CWorldDataCore() override
 	{
 		CWorldData::Data().clear();
-		CWorldSwapPosition::ms_aWorldPositionLogic.clear();
+		CWorldSwapPosition::ms_Routing.Clear();
 	};
 
 	void OnInitWorld(const char* pWhereLocalWorld) override;
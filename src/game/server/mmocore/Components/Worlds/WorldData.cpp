@@ -6,7 +6,7 @@
 
 #include "game/server/gamecontext.h"
 
-std::list < CWorldSwapPosition > CWorldSwapPosition::ms_aWorldPositionLogic;
+CWorldRoutingTable CWorldSwapPosition::ms_Routing;
 
 void CWorldData::Init(int RespawnWorldID, int RequiredQuestID, const std::deque<CWorldSwapData>& Worlds)
 {
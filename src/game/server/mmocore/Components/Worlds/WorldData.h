@@ -3,6 +3,8 @@
 #ifndef GAME_SERVER_COMPONENT_WORLDDATA_H
 #define GAME_SERVER_COMPONENT_WORLDDATA_H
 
+#include <game/server/mmocore/Utils/WorldRouting.h>
+
 using WorldIdentifier = int;
 using WorldDataPtr = std::shared_ptr< class CWorldData >;
 
@@ -67,15 +69,11 @@ public:
 
 
 /* for pathfined
- * Variant World Swap Positions
+ * Routes between the worlds over all loaded swappers
  */
 struct CWorldSwapPosition
 {
-	int m_BaseWorldID;
-	int m_FindWorldID;
-	vec2 m_Position;
-
-	static std::list< CWorldSwapPosition > ms_aWorldPositionLogic;
+	static CWorldRoutingTable ms_Routing;
 };
 
 #endif
\ No newline at end of file
@@ -4,6 +4,8 @@
 #ifndef GAME_ENUM_CONTEXT_H
 #define GAME_ENUM_CONTEXT_H
 
+#include "Utils/Effects.h"
+
 #define GRAY_COLOR vec3(40, 42, 45)
 #define LIGHT_GRAY_COLOR vec3(15, 15, 16)
 #define SMALL_LIGHT_GRAY_COLOR vec3(10, 11, 11)
@@ -269,12 +271,13 @@ public:
 	{
 		int m_ItemID{};
 		std::string m_Effect{};
+		int m_EffectID{};
 		int m_Recovery{};
 		int m_Time{};
 
 	public:
 		Heal() = delete;
-		Heal(int ItemID, std::string Effect, int Recovery, int Time) : m_ItemID(ItemID), m_Effect(Effect), m_Recovery(Recovery), m_Time(Time) {}
+		Heal(int ItemID, std::string Effect, int Recovery, int Time) : m_ItemID(ItemID), m_Effect(Effect), m_EffectID(CEffectRegistry::Get().Intern(Effect.c_str())), m_Recovery(Recovery), m_Time(Time) {}
 
 		static const Heal* getHealInfo(int ItemID)
 		{
@@ -285,6 +288,7 @@ public:
 
 		int getItemID() const { return m_ItemID; }
 		const char* getEffect() const { return m_Effect.c_str(); }
+		int getEffectID() const { return m_EffectID; }
 		int getRecovery() const { return m_Recovery; }
 		int getTime() const { return m_Time; }
 	};
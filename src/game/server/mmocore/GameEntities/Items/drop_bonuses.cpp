@@ -4,6 +4,8 @@
 
 #include <game/server/gamecontext.h>
 
+MACRO_ALLOC_POOL_IMPL(CDropBonuses, 64)
+
 CDropBonuses::CDropBonuses(CGameWorld *pGameWorld, vec2 Pos, vec2 Vel, float AngleForce, int Type, int Value)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_DROPBONUS, Pos, 24)
 {
@@ -30,8 +32,8 @@ void CDropBonuses::Tick()
 	// flashing
 	m_Flash.OnTick();
 
-	// physic
-	GS()->Collision()->MovePhysicalBox(&m_Pos, &m_Vel, vec2(GetProximityRadius(), GetProximityRadius()), 0.5f);
+	// physic, sleeps once the drop lies still
+	m_Body.Move(GS()->Collision(), &m_Pos, &m_Vel, GetProximityRadius(), 0.5f);
 
 	// interactive
 	CCharacter *pChar = (CCharacter*)GameWorld()->ClosestEntity(m_Pos, 16.0f, CGameWorld::ENTTYPE_CHARACTER, 0);
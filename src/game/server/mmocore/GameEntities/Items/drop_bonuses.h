@@ -6,11 +6,14 @@
 
 class CDropBonuses : public CEntity
 {
+	MACRO_ALLOC_POOL()
+
 	vec2 m_Vel;
 	int m_Type;
 	int m_Value;
 	int m_LifeSpan;
 	CFlashingTick m_Flash;
+	CSleepingBox m_Body;
 
 public:
 	CDropBonuses(CGameWorld* pGameWorld, vec2 Pos, vec2 Vel, float AngleForce, int Type, int Value);
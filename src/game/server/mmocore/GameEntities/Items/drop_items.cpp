@@ -6,6 +6,8 @@
 
 #include <base/tl/base.h>
 
+MACRO_ALLOC_POOL_IMPL(CDropItem, 64)
+
 CDropItem::CDropItem(CGameWorld *pGameWorld, vec2 Pos, vec2 Vel, float AngleForce, CItem DropItem, int OwnerID)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_DROPITEM, Pos, 28.0f)
 {
@@ -64,10 +66,13 @@ void CDropItem::Tick()
 	if(m_OwnerID != -1 && !GS()->GetPlayer(m_OwnerID, true, true))
 		m_OwnerID = -1;
 
-	// physic
-	GS()->Collision()->MovePhysicalBox(&m_Pos, &m_Vel, vec2(GetProximityRadius(), GetProximityRadius()), 0.5f);
+	// physic, sleeps once the drop lies still
+	m_Body.Move(GS()->Collision(), &m_Pos, &m_Vel, GetProximityRadius(), 0.5f);
+
+	// information, the broadcast stays for a while so it's enough to check a few times per second
+	if(Server()->Tick() % (Server()->TickSpeed() / 10) != 0)
+		return;
 
-	// information
 	CCharacter *pChar = (CCharacter*)GameWorld()->ClosestEntity(m_Pos, 64.0f, CGameWorld::ENTTYPE_CHARACTER, nullptr);
 	if(pChar && !pChar->GetPlayer()->IsBot())
 	{
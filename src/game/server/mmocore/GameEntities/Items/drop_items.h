@@ -8,11 +8,14 @@
 
 class CDropItem : public CEntity
 {
+	MACRO_ALLOC_POOL()
+
 	CItem m_DropItem;
 	int m_OwnerID;
 	vec2 m_Vel;
 	int m_LifeSpan;
 	CFlashingTick m_Flash;
+	CSleepingBox m_Body;
 
 public:
 	CDropItem(class CGameWorld *pGameWorld, vec2 Pos, vec2 Vel, float AngleForce, CItem DropItem, int OwnerID);
@@ -5,6 +5,8 @@
 
 #include <game/server/gamecontext.h>
 
+MACRO_ALLOC_POOL_IMPL(CDropQuestItem, 32)
+
 CDropQuestItem::CDropQuestItem(CGameWorld *pGameWorld, vec2 Pos, vec2 Vel, float AngleForce, QuestBotInfo BotData, int ClientID)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_DROPQUEST, Pos, 24.0f)
 {
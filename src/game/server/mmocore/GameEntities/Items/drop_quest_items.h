@@ -6,6 +6,8 @@
 
 class CDropQuestItem : public CEntity
 {
+	MACRO_ALLOC_POOL()
+
 	enum
 	{
 		NUM_IDS = 3
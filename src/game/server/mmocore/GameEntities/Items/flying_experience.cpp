@@ -4,6 +4,8 @@
 
 #include <game/server/gamecontext.h>
 
+MACRO_ALLOC_POOL_IMPL(CFlyingExperience, 64)
+
 CFlyingExperience::CFlyingExperience(CGameWorld *pGameWorld, vec2 Pos, int ClientID, int Experience, vec2 InitialVel)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_DROPBONUS, Pos)
 {
@@ -6,6 +6,8 @@
 
 class CFlyingExperience : public CEntity
 {
+	MACRO_ALLOC_POOL()
+
 private:
 	vec2 m_InitialVel;
 	float m_InitialAmount;
@@ -8,7 +8,9 @@ CDecorationHouses::CDecorationHouses(CGameWorld* pGameWorld, vec2 Pos, int House
 	m_HouseID = HouseID;
 	m_DecoID = DecoID;
 
+	// only snapped, never ticked
 	GameWorld()->InsertEntity(this);
+	Sleep();
 
 	if (SwitchToObject(true) >= 0)
 	{
@@ -44,6 +44,7 @@ void CJobItems::SetSpawn(int Sec)
 {
 	m_SpawnTick = Server()->Tick() + (Server()->TickSpeed()*Sec);
 	m_DamageDealt = m_Health;
+	SleepUntil(m_SpawnTick + 1);
 }
 
 void CJobItems::Work(int ClientID)
@@ -74,7 +75,7 @@ bool CJobItems::Interaction(const char* pTool, AttributeIdentifier AttributeDmg,
 	// check equipped
 	if(EquipItem <= 0)
 	{
-		GS()->Broadcast(ClientID, BroadcastPriority::GAME_WARNING, 100, "Need equip {STR}!", Server()->Localization()->Localize(pPlayer->GetLanguage(), pTool));
+		GS()->Broadcast(ClientID, BroadcastPriority::GAME_WARNING, 100, "Need equip {STR}!", Server()->Localization()->Localize(pPlayer->GetLanguageInfo(), pTool));
 		return false;
 	}
 
@@ -152,6 +153,12 @@ void CJobItems::Tick()
 		if(Server()->Tick() > m_SpawnTick)
 			Reset();
 	}
+
+	// nothing to do until it respawns, working on it doesn't need ticks
+	if(m_SpawnTick > 0)
+		SleepUntil(m_SpawnTick + 1);
+	else
+		Sleep();
 }
 
 void CJobItems::TickPaused()
@@ -3,20 +3,33 @@
 #include <engine/server.h>
 #include <engine/shared/config.h>
 
-CLolPlasma::CLolPlasma(CGameWorld* pGameWorld, CEntity* pParent, vec2 Pos, vec2 Vel, int Lifespan)
+MACRO_ALLOC_POOL_IMPL(CLoltext, 32)
+
+CLoltext::CLoltext(CGameWorld* pGameWorld, CEntity* pParent, vec2 Pos, vec2 Vel, int Lifespan, std::vector<vec2>&& aPixels)
 	: CEntity(pGameWorld, CGameWorld::ENTTYPE_WORLD_TEXT, Pos)
 {
+	m_aPixels = std::move(aPixels);
+	m_aIDs.resize(m_aPixels.size());
+	m_aIDs[0] = GetID();
+	for(size_t i = 1; i < m_aIDs.size(); i++)
+		m_aIDs[i] = Server()->SnapNewID();
+
 	m_LocalPos = vec2(0.0f, 0.0f);
 	m_StartOff = Pos;
 	m_Pos = (pParent ? pParent->GetPos() : vec2(0.0f, 0.0f)) + m_StartOff;
 	m_Vel = Vel;
 	m_Life = Lifespan;
-	m_StartTick = Server()->Tick();
 	m_pParent = pParent;
 	GameWorld()->InsertEntity(this);
 }
 
-void CLolPlasma::Tick()
+CLoltext::~CLoltext()
+{
+	for(size_t i = 1; i < m_aIDs.size(); i++)
+		Server()->SnapFreeID(m_aIDs[i]);
+}
+
+void CLoltext::Tick()
 {
 	m_Life--;
 	if(!m_Life)
@@ -27,21 +40,25 @@ void CLolPlasma::Tick()
 	m_Pos = (m_pParent ? m_pParent->GetPos() : vec2(0.0f, 0.0f)) + m_StartOff + (m_LocalPos += m_Vel);
 }
 
-void CLolPlasma::Snap(int SnappingClient)
+void CLoltext::Snap(int SnappingClient)
 {
 	if(NetworkClipped(SnappingClient))
 		return;
 
-	CNetObj_Projectile* pObj = static_cast<CNetObj_Projectile*>(Server()->SnapNewItem(NETOBJTYPE_PROJECTILE, GetID(), sizeof(CNetObj_Projectile)));
-	if(!pObj)
-		return;
+	const int Tick = Server()->Tick();
+	for(size_t i = 0; i < m_aPixels.size(); i++)
+	{
+		CNetObj_Projectile* pObj = static_cast<CNetObj_Projectile*>(Server()->SnapNewItem(NETOBJTYPE_PROJECTILE, m_aIDs[i], sizeof(CNetObj_Projectile)));
+		if(!pObj)
+			return;
 
-	pObj->m_X = (int)m_Pos.x;
-	pObj->m_Y = (int)m_Pos.y;
-	pObj->m_VelX = 0;
-	pObj->m_VelY = 0;
-	pObj->m_StartTick = Server()->Tick();
-	pObj->m_Type = WEAPON_HAMMER;
+		pObj->m_X = (int)(m_Pos.x + m_aPixels[i].x);
+		pObj->m_Y = (int)(m_Pos.y + m_aPixels[i].y);
+		pObj->m_VelX = 0;
+		pObj->m_VelY = 0;
+		pObj->m_StartTick = Tick;
+		pObj->m_Type = WEAPON_HAMMER;
+	}
 }
 
 static bool s_aaaChars[256][5][3] = {
@@ -327,8 +344,15 @@ inline static vec2 TextSize(const char* pText)
 	return vec2(Count * g_Config.m_SvLoltextHspace * 4.0f, g_Config.m_SvLoltextVspace);
 }
 
-void CLoltext::Create(CGameWorld* pGameWorld, CEntity* pParent, vec2 Pos, vec2 Vel, int Lifespan, const char* pText, bool Center, bool Follow)
+bool CLoltext::Create(CGameWorld* pGameWorld, CEntity* pParent, vec2 Pos, vec2 Vel, int Lifespan, const char* pText, bool Center, bool Follow)
 {
+	int NumTexts = 0;
+	for(CEntity* pText = pGameWorld->FindFirst(CGameWorld::ENTTYPE_WORLD_TEXT); pText; pText = pText->TypeNext())
+	{
+		if(++NumTexts >= g_Config.m_SvLoltextMaxPerWorld)
+			return false;
+	}
+
 	vec2 CurPos = Pos;
 	if(Center)
 		CurPos -= TextSize(pText) * 0.5f;
@@ -339,6 +363,9 @@ void CLoltext::Create(CGameWorld* pGameWorld, CEntity* pParent, vec2 Pos, vec2 V
 		pParent = 0;
 	}
 
+	// pixels are relative to the start of the text
+	std::vector<vec2> aPixels;
+	float OffsetX = 0.0f;
 	char c;
 	while((c = *pText++))
 	{
@@ -350,7 +377,13 @@ void CLoltext::Create(CGameWorld* pGameWorld, CEntity* pParent, vec2 Pos, vec2 V
 		for(int y = 0; y < 5/*XXX*/; ++y)
 			for(int x = 0; x < 3/*XXX*/; ++x)
 				if(s_aaaChars[(unsigned)c][y][x])
-					new CLolPlasma(pGameWorld, pParent, CurPos + vec2(x * g_Config.m_SvLoltextHspace, y * g_Config.m_SvLoltextVspace), Vel, Lifespan);
-		CurPos.x += 4 * g_Config.m_SvLoltextHspace;
+					aPixels.emplace_back(OffsetX + x * g_Config.m_SvLoltextHspace, y * g_Config.m_SvLoltextVspace);
+		OffsetX += 4 * g_Config.m_SvLoltextHspace;
 	}
-}
\ No newline at end of file
+
+	if(aPixels.empty())
+		return false;
+
+	new CLoltext(pGameWorld, pParent, CurPos, Vel, Lifespan, std::move(aPixels));
+	return true;
+}
@@ -2,27 +2,31 @@
 #define GAME_SERVER_ENTITIES_LOLTEXT_H
 #include <game/server/entity.h>
 
-class CLolPlasma : public CEntity
+#include <vector>
+
+// one entity for the whole text, the lit pixels are snapped as projectiles
+class CLoltext : public CEntity
 {
+	MACRO_ALLOC_POOL()
+
+	std::vector<vec2> m_aPixels; // offsets from the text position
+	std::vector<int> m_aIDs; // snap ids of the pixels, the first one is the entity id
 	vec2 m_LocalPos; // local coordinate system is origin'd wherever we actually start (i.e. this is (0,0) after creation)
 	vec2 m_Vel;
 	int m_Life; // remaining ticks
-	int m_StartTick; // tick created
 	vec2 m_StartOff; // initial offset from parent, for proper following
 	CEntity* m_pParent;
 
+	CLoltext(CGameWorld* pGameWorld, CEntity* pParent, vec2 Pos, vec2 Vel, int Lifespan, std::vector<vec2>&& aPixels);
+
 public:
-	CLolPlasma(CGameWorld* pGameWorld, CEntity* pParent, vec2 Pos, vec2 Vel, int Lifespan);
+	~CLoltext() override;
 
 	void Tick() override;
 	void Snap(int SnappingClient) override;
-};
 
-class CLoltext
-{
-public:
-	void Create(CGameWorld *pGameWorld, CEntity *pParent, vec2 Pos, vec2 Vel, int Lifespan, const char *pText, bool Center, bool Follow);
+	// returns false if there is nothing to draw or the world has too many texts already
+	static bool Create(CGameWorld *pGameWorld, CEntity *pParent, vec2 Pos, vec2 Vel, int Lifespan, const char *pText, bool Center, bool Follow);
 };
 
 #endif
-
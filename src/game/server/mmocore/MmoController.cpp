@@ -3,6 +3,7 @@
 #include "MmoController.h"
 
 #include <engine/shared/config.h>
+#include <engine/shared/profiler.h>
 #include <game/server/gamecontext.h>
 #include <teeother/system/string.h>
 
@@ -27,22 +28,22 @@
 MmoController::MmoController(CGS *pGameServer) : m_pGameServer(pGameServer)
 {
 	// order
-	m_Components.add(m_pBotsInfo = new CBotCore());
-	m_Components.add(m_pItemWork = new CInventoryCore());
-	m_Components.add(m_pCraftJob = new CCraftCore());
-	m_Components.add(m_pWarehouse = new CWarehouseCore());
-	m_Components.add(new CAuctionCore());
-	m_Components.add(m_pQuest = new QuestCore());
-	m_Components.add(m_pDungeonJob = new DungeonCore());
-	m_Components.add(new CAetherCore());
-	m_Components.add(m_pWorldSwapJob = new CWorldDataCore());
-	m_Components.add(m_pHouseJob = new CHouseCore());
-	m_Components.add(m_pGuildJob = new GuildCore());
-	m_Components.add(m_pSkillJob = new CSkillsCore());
-	m_Components.add(m_pAccMain = new CAccountCore());
-	m_Components.add(m_pAccMiner = new CAccountMinerCore());
-	m_Components.add(m_pAccPlant = new CAccountPlantCore());
-	m_Components.add(m_pMailBoxJob = new CMailBoxCore());
+	m_Components.add(m_pBotsInfo = new CBotCore(), "bots");
+	m_Components.add(m_pItemWork = new CInventoryCore(), "inventory");
+	m_Components.add(m_pCraftJob = new CCraftCore(), "crafts");
+	m_Components.add(m_pWarehouse = new CWarehouseCore(), "warehouse");
+	m_Components.add(new CAuctionCore(), "auction");
+	m_Components.add(m_pQuest = new QuestCore(), "quests");
+	m_Components.add(m_pDungeonJob = new DungeonCore(), "dungeons");
+	m_Components.add(new CAetherCore(), "aethers");
+	m_Components.add(m_pWorldSwapJob = new CWorldDataCore(), "worlds");
+	m_Components.add(m_pHouseJob = new CHouseCore(), "houses");
+	m_Components.add(m_pGuildJob = new GuildCore(), "guilds");
+	m_Components.add(m_pSkillJob = new CSkillsCore(), "skills");
+	m_Components.add(m_pAccMain = new CAccountCore(), "accounts");
+	m_Components.add(m_pAccMiner = new CAccountMinerCore(), "miner");
+	m_Components.add(m_pAccPlant = new CAccountPlantCore(), "plants");
+	m_Components.add(m_pMailBoxJob = new CMailBoxCore(), "mailbox");
 
 	for(auto& pComponent : m_Components.m_paComponents)
 	{
@@ -57,6 +58,13 @@ MmoController::MmoController(CGS *pGameServer) : m_pGameServer(pGameServer)
 		str_format(aLocalSelect, sizeof(aLocalSelect), "WHERE WorldID = '%d'", m_pGameServer->GetWorldID());
 		pComponent->OnInitWorld(aLocalSelect);
 	}
+
+	for(const char* pName : m_Components.m_apNames)
+	{
+		char aSection[64];
+		str_format(aSection, sizeof(aSection), "world%d.mmo.%s", m_pGameServer->GetWorldID(), pName);
+		m_aProfilerSections.push_back(pGameServer->Server()->Profiler()->RegisterSection(aSection));
+	}
 }
 
 MmoController::~MmoController()
@@ -66,8 +74,12 @@ MmoController::~MmoController()
 
 void MmoController::OnTick()
 {
+	int Index = 0;
 	for(auto& pComponent : m_Components.m_paComponents)
+	{
+		CProfileScope Scope(GS()->Server()->Profiler(), m_aProfilerSections[Index++]);
 		pComponent->OnTick();
+	}
 }
 
 void MmoController::OnInitAccount(int ClientID)
@@ -308,6 +320,7 @@ void MmoController::SaveAccount(CPlayer *pPlayer, int Table) const
 	if(Table == SAVE_STATS)
 	{
 		Database->Execute<DB::UPDATE>("tw_accounts_data", "Level = '%d', Exp = '%d' WHERE ID = '%d'", pPlayer->Acc().m_Level, pPlayer->Acc().m_Exp, pPlayer->Acc().m_UserID);
+		CAccountRankingData::ms_Level.Set(pPlayer->Acc().m_UserID, CAccountRankingData::LevelScore(pPlayer->Acc().m_Level, pPlayer->Acc().m_Exp));
 	}
 	else if(Table == SAVE_UPGRADES)
 	{
@@ -365,16 +378,54 @@ void MmoController::LoadLogicWorld() const
 	}
 }
 
-char SaveNick[32];
 const char* MmoController::PlayerName(int AccountID)
 {
-	ResultPtr pRes = Database->Execute<DB::SELECT>("Nick", "tw_accounts_data", "WHERE ID = '%d'", AccountID);
-	if(pRes->next())
+	// a few buffers per thread, so a name stays valid while the next ones are looked up (see the declaration)
+	thread_local char s_aaNames[4][MAX_NAME_LENGTH];
+	thread_local int s_Current = 0;
+	char* pName = s_aaNames[s_Current];
+	s_Current = (s_Current + 1) % 4;
+
+	if(CAccountData::ms_Nicknames.Get(AccountID, pName, MAX_NAME_LENGTH))
+		return pName;
+
+	PrefetchPlayerNames({ AccountID });
+	if(CAccountData::ms_Nicknames.Get(AccountID, pName, MAX_NAME_LENGTH))
+		return pName;
+	return "No found!";
+}
+
+void MmoController::PrefetchPlayerNames(const std::vector<int>& aAccountIDs)
+{
+	std::vector<int> aMissing;
+	CAccountData::ms_Nicknames.GetMissing(aAccountIDs, aMissing);
+
+	// lists are loaded with one query per 64 names
+	for(size_t Start = 0; Start < aMissing.size(); Start += 64)
 	{
-		str_copy(SaveNick, pRes->getString("Nick").c_str(), sizeof(SaveNick));
-		return SaveNick;
+		std::string IDs;
+		for(size_t i = Start; i < aMissing.size() && i < Start + 64; i++)
+		{
+			if(!IDs.empty())
+				IDs += ',';
+			IDs += std::to_string(aMissing[i]);
+		}
+
+		ResultPtr pRes = Database->Execute<DB::SELECT>("ID, Nick", "tw_accounts_data", "WHERE ID IN (%s)", IDs.c_str());
+		std::vector<int> aFound;
+		while(pRes->next())
+		{
+			aFound.push_back(pRes->getInt("ID"));
+			CAccountData::ms_Nicknames.Set(aFound.back(), pRes->getString("Nick").c_str());
+		}
+
+		// deleted accounts are cached too, otherwise every lookup of them queries the database again
+		for(size_t i = Start; i < aMissing.size() && i < Start + 64; i++)
+		{
+			if(std::find(aFound.begin(), aFound.end(), aMissing[i]) == aFound.end())
+				CAccountData::ms_Nicknames.Set(aMissing[i], "No found!");
+		}
 	}
-	return "No found!";
 }
 
 void MmoController::ShowLoadingProgress(const char* pLoading, int Size) const
@@ -387,55 +438,50 @@ void MmoController::ShowLoadingProgress(const char* pLoading, int Size) const
 void MmoController::ShowTopList(CPlayer* pPlayer, int TypeID) const
 {
 	const int ClientID = pPlayer->GetCID();
+	int Rank = 0;
 	if(TypeID == GUILDS_LEVELING)
 	{
-		ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_guilds", "ORDER BY Level DESC, Experience DESC LIMIT 10");
-		while (pRes->next())
+		for(const auto& [GuildID, Score] : CGuildData::ms_LevelRanking.GetTop(10))
 		{
-			char NameGuild[64];
-			const int Rank = pRes->getRow();
-			const int Level = pRes->getInt("Level");
-			const int Experience = pRes->getInt("Experience");
-			str_copy(NameGuild, pRes->getString("Name").c_str(), sizeof(NameGuild));
-			GS()->AVL(ClientID, "null", "{INT}. {STR} :: Level {INT} : Exp {INT}", Rank, NameGuild, Level, Experience);
+			const CGuildData& Guild = CGuildData::ms_aGuild[GuildID];
+			GS()->AVL(ClientID, "null", "{INT}. {STR} :: Level {INT} : Exp {INT}", ++Rank, Guild.m_aName, Guild.m_Level, Guild.m_Exp);
 		}
 	}
 	else if (TypeID == GUILDS_WEALTHY)
 	{
-		ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_guilds", "ORDER BY Bank DESC LIMIT 10");
-		while (pRes->next())
+		for(const auto& [GuildID, Score] : CGuildData::ms_BankRanking.GetTop(10))
 		{
-			char NameGuild[64];
-			const int Rank = pRes->getRow();
-			const int Gold = pRes->getInt("Bank");
-			str_copy(NameGuild, pRes->getString("Name").c_str(), sizeof(NameGuild));
-			GS()->AVL(ClientID, "null", "{INT}. {STR} :: Gold {VAL}", Rank, NameGuild, Gold);
+			const int Gold = (int)Score;
+			GS()->AVL(ClientID, "null", "{INT}. {STR} :: Gold {VAL}", ++Rank, CGuildData::ms_aGuild[GuildID].m_aName, Gold);
 		}
 	}
 	else if (TypeID == PLAYERS_LEVELING)
 	{
-		ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_accounts_data", "ORDER BY Level DESC, Exp DESC LIMIT 10");
-		while (pRes->next())
+		const auto aTop = CAccountRankingData::ms_Level.GetTop(10);
+		std::vector<int> aAccountIDs;
+		for(const auto& [UserID, Score] : aTop)
+			aAccountIDs.push_back(UserID);
+		PrefetchPlayerNames(aAccountIDs);
+
+		for(const auto& [UserID, Score] : aTop)
 		{
-			char Nick[64];
-			const int Rank = pRes->getRow();
-			const int Level = pRes->getInt("Level");
-			const int Experience = pRes->getInt("Exp");
-			str_copy(Nick, pRes->getString("Nick").c_str(), sizeof(Nick));
-			GS()->AVL(ClientID, "null", "{INT}. {STR} :: Level {INT} : Exp {INT}", Rank, Nick, Level, Experience);
+			const int Level = (int)(Score >> 32);
+			const int Experience = (int)(Score & 0xffffffff);
+			GS()->AVL(ClientID, "null", "{INT}. {STR} :: Level {INT} : Exp {INT}", ++Rank, PlayerName(UserID), Level, Experience);
 		}
 	}
 	else if (TypeID == PLAYERS_WEALTHY)
 	{
-		ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_accounts_items", "WHERE ItemID = '%d' ORDER BY Value DESC LIMIT 10", (ItemIdentifier)itGold);
-		while (pRes->next())
+		const auto aTop = CAccountRankingData::ms_Gold.GetTop(10);
+		std::vector<int> aAccountIDs;
+		for(const auto& [UserID, Score] : aTop)
+			aAccountIDs.push_back(UserID);
+		PrefetchPlayerNames(aAccountIDs);
+
+		for(const auto& [UserID, Score] : aTop)
 		{
-			char Nick[64];
-			const int Rank = pRes->getRow();
-			const int Gold = pRes->getInt("Value");
-			const int UserID = pRes->getInt("UserID");
-			str_copy(Nick, PlayerName(UserID), sizeof(Nick));
-			GS()->AVL(ClientID, "null", "{INT}. {STR} :: Gold {VAL}", Rank, Nick, Gold);
+			const int Gold = (int)Score;
+			GS()->AVL(ClientID, "null", "{INT}. {STR} :: Gold {VAL}", ++Rank, PlayerName(UserID), Gold);
 		}
 	}
 }
@@ -15,9 +15,10 @@ class MmoController
 	class CStack
 	{
 	public:
-		void add(class MmoComponent *pComponent)
+		void add(class MmoComponent *pComponent, const char *pName)
 		{
  			m_paComponents.push_back(pComponent);
+			m_apNames.push_back(pName);
 		}
 
 		void free()
@@ -25,11 +26,14 @@ class MmoController
 			for(auto* pComponent : m_paComponents)
 				delete pComponent;
 			m_paComponents.clear();
+			m_apNames.clear();
 		}
 
 		std::list < class MmoComponent *> m_paComponents;
+		std::vector < const char *> m_apNames;
 	};
 	CStack m_Components;
+	std::vector < int > m_aProfilerSections;
 
 	class CAccountCore*m_pAccMain;
 	class CBotCore *m_pBotsInfo;
@@ -81,7 +85,10 @@ public:
 	void ConAsyncLinesForTranslate();
 	//
 	void LoadLogicWorld() const;
+	// the name is in a ring of 4 buffers per thread: it stays valid until the 4th PlayerName call after it
+	// on the same thread, so copy it when more names are looked up before it's used (e.g. building a list)
 	static const char* PlayerName(int AccountID);
+	static void PrefetchPlayerNames(const std::vector<int>& aAccountIDs);
 	void SaveAccount(CPlayer *pPlayer, int Table) const;
 	void ShowLoadingProgress(const char* pLoading, int Size) const;
 
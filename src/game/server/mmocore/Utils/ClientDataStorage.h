@@ -0,0 +1,164 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#ifndef GAME_SERVER_MMOCORE_UTILS_CLIENT_DATA_STORAGE_H
+#define GAME_SERVER_MMOCORE_UTILS_CLIENT_DATA_STORAGE_H
+
+#include <base/system.h>
+#include <engine/shared/protocol.h>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/*
+	Map replacement for small per-player tables (items, skills, quests).
+	Values live in a deque so pointers stay valid when new keys are added,
+	lookups go through a sorted key vector and iteration is in key order,
+	the same as with std::map. Single keys can't be erased, only cleared.
+*/
+template < typename TKey, typename TValue >
+class CFlatStableMap
+{
+public:
+	using key_type = TKey;
+	using mapped_type = TValue;
+	using value_type = std::pair< const TKey, TValue >;
+
+private:
+	using IndexEntry = std::pair< TKey, int >;
+	std::deque< value_type > m_aValues;
+	std::vector< IndexEntry > m_aIndex;
+	int m_Version = 0;
+
+	typename std::vector< IndexEntry >::const_iterator LowerBound(const TKey& Key) const
+	{
+		return std::lower_bound(m_aIndex.begin(), m_aIndex.end(), Key, [](const IndexEntry& Entry, const TKey& Key) { return Entry.first < Key; });
+	}
+
+	// iterators survive inserts like std::map ones do, after an insert the
+	// position is looked up again from the key of the current value
+	template < bool Const >
+	class CIterator
+	{
+		using Map = std::conditional_t< Const, const CFlatStableMap, CFlatStableMap >;
+		Map* m_pMap;
+		int m_Pos;
+		int m_ValueIndex; // -1 at the end
+		int m_Version;
+		friend class CFlatStableMap;
+		template < bool > friend class CIterator;
+
+		CIterator(Map* pMap, int Pos) : m_pMap(pMap), m_Pos(Pos), m_Version(pMap->m_Version)
+		{
+			m_ValueIndex = Pos < (int)pMap->m_aIndex.size() ? pMap->m_aIndex[Pos].second : -1;
+		}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename CFlatStableMap::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t< Const, const value_type&, value_type& >;
+		using pointer = std::conditional_t< Const, const value_type*, value_type* >;
+
+		CIterator() : m_pMap(nullptr), m_Pos(0), m_ValueIndex(-1), m_Version(0) {}
+		template < bool OtherConst, typename = std::enable_if_t< Const && !OtherConst > >
+		CIterator(const CIterator< OtherConst >& Other) : m_pMap(Other.m_pMap), m_Pos(Other.m_Pos), m_ValueIndex(Other.m_ValueIndex), m_Version(Other.m_Version) {}
+
+		reference operator*() const { return m_pMap->m_aValues[m_ValueIndex]; }
+		pointer operator->() const { return &m_pMap->m_aValues[m_ValueIndex]; }
+		CIterator& operator++()
+		{
+			if(m_Version != m_pMap->m_Version)
+			{
+				m_Pos = (int)(m_pMap->LowerBound(m_pMap->m_aValues[m_ValueIndex].first) - m_pMap->m_aIndex.begin());
+				m_Version = m_pMap->m_Version;
+			}
+			*this = CIterator(m_pMap, m_Pos + 1);
+			return *this;
+		}
+		CIterator operator++(int) { CIterator Old = *this; ++*this; return Old; }
+		bool operator==(const CIterator& Other) const { return m_ValueIndex == Other.m_ValueIndex; }
+		bool operator!=(const CIterator& Other) const { return m_ValueIndex != Other.m_ValueIndex; }
+	};
+
+public:
+	using iterator = CIterator< false >;
+	using const_iterator = CIterator< true >;
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, (int)m_aIndex.size()); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, (int)m_aIndex.size()); }
+
+	size_t size() const { return m_aIndex.size(); }
+	bool empty() const { return m_aIndex.empty(); }
+	size_t count(const TKey& Key) const { return find(Key) != end(); }
+
+	iterator find(const TKey& Key)
+	{
+		auto It = LowerBound(Key);
+		return iterator(this, It != m_aIndex.cend() && It->first == Key ? (int)(It - m_aIndex.cbegin()) : (int)m_aIndex.size());
+	}
+
+	const_iterator find(const TKey& Key) const
+	{
+		auto It = LowerBound(Key);
+		return const_iterator(this, It != m_aIndex.cend() && It->first == Key ? (int)(It - m_aIndex.cbegin()) : (int)m_aIndex.size());
+	}
+
+	TValue& operator[](const TKey& Key)
+	{
+		auto It = LowerBound(Key);
+		if(It != m_aIndex.cend() && It->first == Key)
+			return m_aValues[It->second].second;
+
+		m_aValues.emplace_back(std::piecewise_construct, std::forward_as_tuple(Key), std::forward_as_tuple());
+		m_aIndex.insert(It, IndexEntry(Key, (int)m_aValues.size() - 1));
+		m_Version++;
+		return m_aValues.back().second;
+	}
+
+	void clear()
+	{
+		m_aValues.clear();
+		m_aIndex.clear();
+		m_Version++;
+	}
+};
+
+/*
+	Per client storage indexed directly by ClientID instead of a map lookup.
+*/
+template < typename TInner, int Size = MAX_CLIENTS >
+class CClientDataStorage
+{
+	std::array< TInner, Size > m_aData;
+
+public:
+	TInner& operator[](int ClientID)
+	{
+		dbg_assert(ClientID >= 0 && ClientID < Size, "client data storage out of range");
+		return m_aData[ClientID];
+	}
+
+	void erase(int ClientID)
+	{
+		if(ClientID >= 0 && ClientID < Size)
+			m_aData[ClientID].clear();
+	}
+
+	void clear()
+	{
+		for(auto& Inner : m_aData)
+			Inner.clear();
+	}
+};
+
+template < typename TKey, typename TValue >
+using CClientFlatStorage = CClientDataStorage< CFlatStableMap< TKey, TValue > >;
+
+#endif
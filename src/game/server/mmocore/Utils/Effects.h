@@ -0,0 +1,140 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#ifndef GAME_SERVER_MMOCORE_UTILS_EFFECTS_H
+#define GAME_SERVER_MMOCORE_UTILS_EFFECTS_H
+
+#include <base/system.h>
+
+#include <mutex>
+
+// effects used directly by the code, registered first so the ids are fixed
+enum EffectIdentifier
+{
+	EFFECT_SLOWDOWN = 0,
+	EFFECT_FIRE,
+	EFFECT_POISON,
+	EFFECT_REGEN_MANA,
+	NUM_DEFAULT_EFFECTS,
+
+	MAX_EFFECTS = 32,
+	EFFECT_NONE = -1,
+};
+
+/*
+	Effect names are interned once (items, mob buffs, quests) into small ids,
+	so the players keep the effects in a bitmask instead of a string map.
+*/
+class CEffectRegistry
+{
+	char m_aaNames[MAX_EFFECTS][32];
+	int m_Num;
+	mutable std::mutex m_Mutex;
+
+	CEffectRegistry() : m_Num(0)
+	{
+		const char* apDefault[NUM_DEFAULT_EFFECTS] = { "Slowdown", "Fire", "Poison", "RegenMana" };
+		for(const char* pName : apDefault)
+			str_copy(m_aaNames[m_Num++], pName, sizeof(m_aaNames[0]));
+	}
+
+	int FindUnlocked(const char* pName) const
+	{
+		for(int i = 0; i < m_Num; i++)
+		{
+			if(str_comp(m_aaNames[i], pName) == 0)
+				return i;
+		}
+		return EFFECT_NONE;
+	}
+
+public:
+	static CEffectRegistry& Get()
+	{
+		static CEffectRegistry s_Registry;
+		return s_Registry;
+	}
+
+	// returns the id of the effect, registering it on first use
+	int Intern(const char* pName)
+	{
+		if(!pName || !pName[0])
+			return EFFECT_NONE;
+
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		int ID = FindUnlocked(pName);
+		if(ID != EFFECT_NONE)
+			return ID;
+
+		if(m_Num >= MAX_EFFECTS)
+		{
+			dbg_msg("effects", "can't register effect '%s', limit of %d reached", pName, (int)MAX_EFFECTS);
+			return EFFECT_NONE;
+		}
+
+		str_copy(m_aaNames[m_Num], pName, sizeof(m_aaNames[0]));
+		return m_Num++;
+	}
+
+	int Find(const char* pName) const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		return FindUnlocked(pName);
+	}
+
+	// names are never removed or changed after registration
+	const char* Name(int ID) const { return ID >= 0 && ID < MAX_EFFECTS ? m_aaNames[ID] : ""; }
+	int Num() const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		return m_Num;
+	}
+};
+
+/*
+	Remaining seconds of the effects of one player, active ones are marked in a mask.
+*/
+class CEffectTimers
+{
+	unsigned m_ActiveMask = 0;
+	int m_aSeconds[MAX_EFFECTS] = {};
+
+public:
+	bool IsActive(int ID) const { return ID >= 0 && ID < MAX_EFFECTS && (m_ActiveMask & (1u << ID)); }
+	bool Empty() const { return m_ActiveMask == 0; }
+	int GetSeconds(int ID) const { return IsActive(ID) ? m_aSeconds[ID] : 0; }
+
+	void Set(int ID, int Seconds)
+	{
+		if(ID < 0 || ID >= MAX_EFFECTS)
+			return;
+
+		if(Seconds <= 0)
+		{
+			m_ActiveMask &= ~(1u << ID);
+			return;
+		}
+		m_aSeconds[ID] = Seconds;
+		m_ActiveMask |= 1u << ID;
+	}
+
+	void Clear() { m_ActiveMask = 0; }
+
+	// one second passed, calls OnExpire(ID) for each effect that ran out
+	template < typename F >
+	void Tick(F&& OnExpire)
+	{
+		for(int ID = 0; ID < MAX_EFFECTS && (m_ActiveMask >> ID); ID++)
+		{
+			if(!(m_ActiveMask & (1u << ID)))
+				continue;
+
+			if(--m_aSeconds[ID] <= 0)
+			{
+				m_ActiveMask &= ~(1u << ID);
+				OnExpire(ID);
+			}
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,136 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#ifndef GAME_SERVER_MMOCORE_UTILS_ID_ALLOCATOR_H
+#define GAME_SERVER_MMOCORE_UTILS_ID_ALLOCATOR_H
+
+#include <engine/engine.h>
+#include <engine/server/sql_connect_pool.h>
+
+#include <mutex>
+
+// tables that get their ids from the server before the insert
+enum IdSequence
+{
+	ID_ACCOUNTS = 0,
+	ID_GUILDS,
+	ID_GUILD_RANKS,
+	ID_GUILD_DECORATIONS,
+	ID_HOUSE_DECORATIONS,
+	ID_AUCTION_ITEMS,
+	NUM_ID_SEQUENCES,
+};
+
+/*
+	Hands out ids from blocks reserved in tw_id_sequences, so the inserts can stay
+	asynchronous and no two servers or threads get the same id. The first block is
+	reserved on startup, the next one on the engine jobs once half of the current
+	one is used.
+*/
+class CIdAllocator
+{
+	class CRefillJob : public IJob
+	{
+		CIdAllocator* m_pAllocator;
+		void Run() override { m_pAllocator->Refill(); }
+
+	public:
+		explicit CRefillJob(CIdAllocator* pAllocator) : m_pAllocator(pAllocator) {}
+	};
+
+	static inline IEngine* ms_pEngine = nullptr;
+	const char* m_pTable;
+	int m_BlockSize;
+	int m_Next = 0;
+	int m_End = 0;
+	int m_Reserved = 0;
+	int m_ReservedEnd = 0;
+	bool m_Refilling = false;
+	std::mutex m_Mutex;
+
+	CIdAllocator(const char* pTable, int BlockSize) : m_pTable(pTable), m_BlockSize(BlockSize) {}
+
+	void Refill()
+	{
+		const int FirstID = Database->ReserveIDs(m_pTable, m_BlockSize);
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		if(FirstID > 0)
+		{
+			m_Reserved = FirstID;
+			m_ReservedEnd = FirstID + m_BlockSize;
+		}
+		m_Refilling = false;
+	}
+
+	// the engine joins its job threads on shutdown, unlike a detached thread
+	void RefillAsync()
+	{
+		if(!ms_pEngine)
+			return;
+
+		m_Refilling = true;
+		ms_pEngine->AddJob(std::make_shared<CRefillJob>(this));
+	}
+
+public:
+	static void Init(IEngine* pEngine) { ms_pEngine = pEngine; }
+
+	static CIdAllocator& Get(IdSequence Sequence)
+	{
+		static CIdAllocator s_aAllocators[NUM_ID_SEQUENCES] = {
+			{ "tw_accounts", 8 },
+			{ "tw_guilds", 4 },
+			{ "tw_guilds_ranks", 8 },
+			{ "tw_guilds_decorations", 16 },
+			{ "tw_houses_decorations", 16 },
+			{ "tw_auction_items", 16 },
+		};
+		return s_aAllocators[Sequence];
+	}
+
+	// returns -1 if no id could be reserved
+	int Allocate()
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		if(m_Next >= m_End)
+		{
+			if(m_ReservedEnd > m_Reserved)
+			{
+				m_Next = m_Reserved;
+				m_End = m_ReservedEnd;
+				m_Reserved = m_ReservedEnd = 0;
+			}
+			else
+			{
+				// nothing prefetched, only blocks here when the reservations failed or can't keep up
+				const int FirstID = Database->ReserveIDs(m_pTable, m_BlockSize);
+				if(FirstID <= 0)
+					return -1;
+
+				m_Next = FirstID;
+				m_End = FirstID + m_BlockSize;
+			}
+		}
+
+		const int ID = m_Next++;
+		if(!m_Refilling && m_ReservedEnd == m_Reserved && (m_End - m_Next) * 2 <= m_BlockSize)
+			RefillAsync();
+		return ID;
+	}
+
+	// reserves the first block before returning, called on startup so no player waits for it
+	void Prefetch()
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		if(m_Refilling || m_Next < m_End || m_ReservedEnd > m_Reserved)
+			return;
+
+		const int FirstID = Database->ReserveIDs(m_pTable, m_BlockSize);
+		if(FirstID > 0)
+		{
+			m_Next = FirstID;
+			m_End = FirstID + m_BlockSize;
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,228 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#ifndef GAME_SERVER_MMOCORE_UTILS_LEADERBOARD_H
+#define GAME_SERVER_MMOCORE_UTILS_LEADERBOARD_H
+
+#include <base/system.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+	Ranking of IDs by score (highest first, lower ID first on equal scores).
+	A treap with subtree sizes, so updates and rank lookups are O(log n).
+	Guarded by a mutex, rankings are loaded from the sql threads.
+*/
+class CLeaderboard
+{
+	struct CNode
+	{
+		int64 m_Score;
+		int m_ID;
+		unsigned m_Priority;
+		int m_Size;
+		int m_aChild[2];
+	};
+
+	std::vector<CNode> m_aNodes;
+	std::vector<int> m_aFreeNodes;
+	std::unordered_map<int, int> m_aIndex;
+	int m_Root = -1;
+	unsigned m_Seed = 0x9e3779b9;
+	mutable std::mutex m_Mutex;
+
+	int Size(int Node) const { return Node < 0 ? 0 : m_aNodes[Node].m_Size; }
+	void Update(int Node) { m_aNodes[Node].m_Size = 1 + Size(m_aNodes[Node].m_aChild[0]) + Size(m_aNodes[Node].m_aChild[1]); }
+
+	static bool Before(int64 Score, int ID, const CNode& Node)
+	{
+		return Score > Node.m_Score || (Score == Node.m_Score && ID < Node.m_ID);
+	}
+
+	// splits into nodes ranked before the key and the rest
+	void Split(int Node, int64 Score, int ID, int *pLeft, int *pRight)
+	{
+		if(Node < 0)
+		{
+			*pLeft = *pRight = -1;
+			return;
+		}
+
+		CNode& Current = m_aNodes[Node];
+		if(Before(Score, ID, Current))
+		{
+			Split(Current.m_aChild[0], Score, ID, pLeft, &m_aNodes[Node].m_aChild[0]);
+			*pRight = Node;
+		}
+		else
+		{
+			Split(Current.m_aChild[1], Score, ID, &m_aNodes[Node].m_aChild[1], pRight);
+			*pLeft = Node;
+		}
+		Update(Node);
+	}
+
+	int Merge(int Left, int Right)
+	{
+		if(Left < 0 || Right < 0)
+			return Left < 0 ? Right : Left;
+
+		if(m_aNodes[Left].m_Priority > m_aNodes[Right].m_Priority)
+		{
+			m_aNodes[Left].m_aChild[1] = Merge(m_aNodes[Left].m_aChild[1], Right);
+			Update(Left);
+			return Left;
+		}
+
+		m_aNodes[Right].m_aChild[0] = Merge(Left, m_aNodes[Right].m_aChild[0]);
+		Update(Right);
+		return Right;
+	}
+
+	int Erase(int Node, int64 Score, int ID)
+	{
+		if(Node < 0)
+			return -1;
+
+		CNode& Current = m_aNodes[Node];
+		if(Current.m_ID == ID)
+		{
+			m_aFreeNodes.push_back(Node);
+			return Merge(Current.m_aChild[0], Current.m_aChild[1]);
+		}
+
+		const int Side = Before(Score, ID, Current) ? 0 : 1;
+		const int Child = Erase(Current.m_aChild[Side], Score, ID);
+		m_aNodes[Node].m_aChild[Side] = Child;
+		Update(Node);
+		return Node;
+	}
+
+	void RemoveLocked(int ID)
+	{
+		auto It = m_aIndex.find(ID);
+		if(It == m_aIndex.end())
+			return;
+
+		m_Root = Erase(m_Root, m_aNodes[It->second].m_Score, ID);
+		m_aIndex.erase(It);
+	}
+
+public:
+	void Clear()
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_aNodes.clear();
+		m_aFreeNodes.clear();
+		m_aIndex.clear();
+		m_Root = -1;
+	}
+
+	int Num() const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		return Size(m_Root);
+	}
+
+	// inserts the id or moves it to its new score
+	void Set(int ID, int64 Score)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		auto It = m_aIndex.find(ID);
+		if(It != m_aIndex.end())
+		{
+			if(m_aNodes[It->second].m_Score == Score)
+				return;
+			RemoveLocked(ID);
+		}
+
+		int Node;
+		if(!m_aFreeNodes.empty())
+		{
+			Node = m_aFreeNodes.back();
+			m_aFreeNodes.pop_back();
+		}
+		else
+		{
+			Node = (int)m_aNodes.size();
+			m_aNodes.emplace_back();
+		}
+
+		m_Seed ^= m_Seed << 13;
+		m_Seed ^= m_Seed >> 17;
+		m_Seed ^= m_Seed << 5;
+
+		CNode& New = m_aNodes[Node];
+		New.m_Score = Score;
+		New.m_ID = ID;
+		New.m_Priority = m_Seed;
+		New.m_Size = 1;
+		New.m_aChild[0] = New.m_aChild[1] = -1;
+		m_aIndex[ID] = Node;
+
+		int Left, Right;
+		Split(m_Root, Score, ID, &Left, &Right);
+		m_Root = Merge(Merge(Left, Node), Right);
+	}
+
+	void Remove(int ID)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		RemoveLocked(ID);
+	}
+
+	// 1 for the highest score, -1 if the id is not ranked
+	int GetRank(int ID) const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		auto It = m_aIndex.find(ID);
+		if(It == m_aIndex.end())
+			return -1;
+
+		const int64 Score = m_aNodes[It->second].m_Score;
+		int Rank = 0;
+		int Node = m_Root;
+		while(Node >= 0)
+		{
+			const CNode& Current = m_aNodes[Node];
+			if(Current.m_ID == ID)
+				return Rank + Size(Current.m_aChild[0]) + 1;
+
+			if(Before(Score, ID, Current))
+				Node = Current.m_aChild[0];
+			else
+			{
+				Rank += Size(Current.m_aChild[0]) + 1;
+				Node = Current.m_aChild[1];
+			}
+		}
+		return -1;
+	}
+
+	// the best ranked ids with their scores, in order
+	std::vector<std::pair<int, int64>> GetTop(int Count) const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		std::vector<std::pair<int, int64>> aTop;
+		std::vector<int> aStack;
+		int Node = m_Root;
+		while((Node >= 0 || !aStack.empty()) && (int)aTop.size() < Count)
+		{
+			while(Node >= 0)
+			{
+				aStack.push_back(Node);
+				Node = m_aNodes[Node].m_aChild[0];
+			}
+
+			Node = aStack.back();
+			aStack.pop_back();
+			aTop.emplace_back(m_aNodes[Node].m_ID, m_aNodes[Node].m_Score);
+			Node = m_aNodes[Node].m_aChild[1];
+		}
+		return aTop;
+	}
+};
+
+#endif
@@ -0,0 +1,146 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#ifndef GAME_SERVER_MMOCORE_UTILS_NICKNAME_CACHE_H
+#define GAME_SERVER_MMOCORE_UTILS_NICKNAME_CACHE_H
+
+#include <base/system.h>
+
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+	Account ID to nickname, bounded by a least recently used list.
+	Online players are pinned and never evicted, offline names are
+	filled in by the owner in batches (see GetMissing). Used from the
+	vote jobs as well, so every access is locked.
+*/
+class CNicknameCache
+{
+	struct CEntry
+	{
+		std::string m_Name;
+		std::list<int>::iterator m_LruPos;
+		bool m_Online;
+	};
+
+	std::unordered_map<int, CEntry> m_aEntries;
+	std::list<int> m_aLru; // most recently used first
+	int m_Capacity;
+	mutable std::mutex m_Mutex;
+
+	void Touch(CEntry& Entry)
+	{
+		m_aLru.splice(m_aLru.begin(), m_aLru, Entry.m_LruPos);
+	}
+
+	void EvictUnlocked()
+	{
+		auto Iter = m_aLru.end();
+		while((int)m_aEntries.size() > m_Capacity && Iter != m_aLru.begin())
+		{
+			--Iter;
+			const auto Entry = m_aEntries.find(*Iter);
+			if(Entry->second.m_Online)
+				continue;
+
+			m_aEntries.erase(Entry);
+			Iter = m_aLru.erase(Iter);
+		}
+	}
+
+	CEntry& SetUnlocked(int ID, const char* pName)
+	{
+		auto Iter = m_aEntries.find(ID);
+		if(Iter == m_aEntries.end())
+		{
+			m_aLru.push_front(ID);
+			Iter = m_aEntries.emplace(ID, CEntry{ pName, m_aLru.begin(), false }).first;
+		}
+		else
+		{
+			Iter->second.m_Name = pName;
+			Touch(Iter->second);
+		}
+		return Iter->second;
+	}
+
+public:
+	explicit CNicknameCache(int Capacity = 1024) : m_Capacity(Capacity) {}
+
+	void SetCapacity(int Capacity)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_Capacity = std::max(Capacity, 1);
+		EvictUnlocked();
+	}
+
+	// copies the nickname to the buffer, returns false if it's not cached
+	bool Get(int ID, char* pBuffer, int BufferSize)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		const auto Iter = m_aEntries.find(ID);
+		if(Iter == m_aEntries.end())
+			return false;
+
+		Touch(Iter->second);
+		str_copy(pBuffer, Iter->second.m_Name.c_str(), BufferSize);
+		return true;
+	}
+
+	void Set(int ID, const char* pName)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		SetUnlocked(ID, pName);
+		EvictUnlocked();
+	}
+
+	// online players stay cached until they leave
+	void SetOnline(int ID, const char* pName)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		SetUnlocked(ID, pName).m_Online = true;
+		EvictUnlocked();
+	}
+
+	void SetOffline(int ID)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		const auto Iter = m_aEntries.find(ID);
+		if(Iter == m_aEntries.end())
+			return;
+
+		Iter->second.m_Online = false;
+		EvictUnlocked();
+	}
+
+	// collects the ids that have to be loaded, without duplicates
+	void GetMissing(const std::vector<int>& aIDs, std::vector<int>& aMissing) const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		aMissing.clear();
+		for(int ID : aIDs)
+		{
+			if(ID > 0 && !m_aEntries.count(ID) && std::find(aMissing.begin(), aMissing.end(), ID) == aMissing.end())
+				aMissing.push_back(ID);
+		}
+	}
+
+	int Num() const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		return (int)m_aEntries.size();
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_aEntries.clear();
+		m_aLru.clear();
+	}
+};
+
+#endif
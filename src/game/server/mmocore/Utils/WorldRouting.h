@@ -0,0 +1,136 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#ifndef GAME_SERVER_MMOCORE_UTILS_WORLD_ROUTING_H
+#define GAME_SERVER_MMOCORE_UTILS_WORLD_ROUTING_H
+
+#include <base/vmath.h>
+
+#include <deque>
+#include <vector>
+
+/*
+	Next hop table over the world swappers. Every pair of worlds gets the
+	swapper to take first on the shortest route (by the number of swaps),
+	so the lookup is a single index. The table is rebuilt on the first
+	lookup after new swappers were added.
+*/
+class CWorldRoutingTable
+{
+	struct CSwap
+	{
+		int m_From;
+		int m_To;
+		vec2 m_Position;
+	};
+
+	std::vector<CSwap> m_aSwaps;
+	std::vector<int> m_aNextSwap; // [From * m_NumWorlds + To], index in m_aSwaps or -1
+	std::vector<int> m_aDistance; // number of swaps, -1 if unreachable
+	int m_NumWorlds = 0;
+	bool m_Dirty = false;
+
+	int Index(int From, int To) const { return From * m_NumWorlds + To; }
+	bool IsValid(int WorldID) const { return WorldID >= 0 && WorldID < m_NumWorlds; }
+
+public:
+	// the swapper at Position in the world From leads to the world To, returns false for duplicates
+	bool AddSwap(int From, int To, vec2 Position)
+	{
+		if(From < 0 || To < 0 || From == To)
+			return false;
+
+		for(const CSwap& Swap : m_aSwaps)
+		{
+			if(Swap.m_From == From && Swap.m_To == To && Swap.m_Position.x == Position.x && Swap.m_Position.y == Position.y)
+				return false;
+		}
+
+		m_aSwaps.push_back({ From, To, Position });
+		m_Dirty = true;
+		return true;
+	}
+
+	void Build()
+	{
+		m_NumWorlds = 0;
+		for(const CSwap& Swap : m_aSwaps)
+			m_NumWorlds = max(m_NumWorlds, max(Swap.m_From, Swap.m_To) + 1);
+
+		// adjacency in the order the swappers were added, the first one wins between equal routes
+		std::vector<std::vector<int>> aaOutgoing(m_NumWorlds);
+		for(int i = 0; i < (int)m_aSwaps.size(); i++)
+			aaOutgoing[m_aSwaps[i].m_From].push_back(i);
+
+		m_aNextSwap.assign(m_NumWorlds * m_NumWorlds, -1);
+		m_aDistance.assign(m_NumWorlds * m_NumWorlds, -1);
+
+		// breadth first from every world, the first swap is carried along the route
+		std::deque<int> aQueue;
+		for(int Start = 0; Start < m_NumWorlds; Start++)
+		{
+			m_aDistance[Index(Start, Start)] = 0;
+			aQueue.assign(1, Start);
+			while(!aQueue.empty())
+			{
+				const int WorldID = aQueue.front();
+				aQueue.pop_front();
+				for(int SwapID : aaOutgoing[WorldID])
+				{
+					const int Next = m_aSwaps[SwapID].m_To;
+					if(m_aDistance[Index(Start, Next)] >= 0)
+						continue;
+
+					m_aDistance[Index(Start, Next)] = m_aDistance[Index(Start, WorldID)] + 1;
+					m_aNextSwap[Index(Start, Next)] = WorldID == Start ? SwapID : m_aNextSwap[Index(Start, WorldID)];
+					aQueue.push_back(Next);
+				}
+			}
+		}
+		m_Dirty = false;
+	}
+
+	// position of the swapper in From to go through next on the way to To
+	bool GetNextSwap(int From, int To, vec2* pOutPos)
+	{
+		if(m_Dirty)
+			Build();
+		if(!IsValid(From) || !IsValid(To) || m_aNextSwap[Index(From, To)] < 0)
+			return false;
+
+		*pOutPos = m_aSwaps[m_aNextSwap[Index(From, To)]].m_Position;
+		return true;
+	}
+
+	// world reached after the next swap, -1 if there is no route
+	int GetNextWorld(int From, int To)
+	{
+		if(m_Dirty)
+			Build();
+		if(!IsValid(From) || !IsValid(To) || m_aNextSwap[Index(From, To)] < 0)
+			return -1;
+		return m_aSwaps[m_aNextSwap[Index(From, To)]].m_To;
+	}
+
+	// number of swaps on the shortest route, -1 if there is no route
+	int GetDistance(int From, int To)
+	{
+		if(m_Dirty)
+			Build();
+		if(From == To)
+			return 0;
+		if(!IsValid(From) || !IsValid(To))
+			return -1;
+		return m_aDistance[Index(From, To)];
+	}
+
+	void Clear()
+	{
+		m_aSwaps.clear();
+		m_aNextSwap.clear();
+		m_aDistance.clear();
+		m_NumWorlds = 0;
+		m_Dirty = false;
+	}
+};
+
+#endif
@@ -25,6 +25,8 @@ CPlayer::CPlayer(CGS *pGS, int ClientID) : m_pGS(pGS), m_ClientID(ClientID)
 	m_EidolonCID = -1;
 	m_Spawned = true;
 	m_SnapHealthTick = 0;
+	m_AttributesCacheValid = false;
+	m_HudValid = false;
 	m_aPlayerTick[Respawn] = Server()->Tick() + Server()->TickSpeed();
 	m_aPlayerTick[Die] = Server()->Tick();
 	m_PrevTuningParams = *pGS->Tuning();
@@ -162,21 +164,13 @@ void CPlayer::TryRemoveEidolon()
 
 void CPlayer::EffectsTick()
 {
-	if(Server()->Tick() % Server()->TickSpeed() != 0 || CGS::ms_aEffects[m_ClientID].empty())
+	if(Server()->Tick() % Server()->TickSpeed() != 0 || CGS::ms_aEffects[m_ClientID].Empty())
 		return;
 
-	for(auto pEffect = CGS::ms_aEffects[m_ClientID].begin(); pEffect != CGS::ms_aEffects[m_ClientID].end();)
+	CGS::ms_aEffects[m_ClientID].Tick([this](int EffectID)
 	{
-		pEffect->second--;
-		if(pEffect->second <= 0)
-		{
-			GS()->Chat(m_ClientID, "You lost the effect {STR}.", pEffect->first.c_str());
-			pEffect = CGS::ms_aEffects[m_ClientID].erase(pEffect);
-			continue;
-		}
-
-		++pEffect;
-	}
+		GS()->Chat(m_ClientID, "You lost the effect {STR}.", CEffectRegistry::Get().Name(EffectID));
+	});
 }
 
 void CPlayer::TickSystemTalk()
@@ -440,27 +434,30 @@ bool CPlayer::SpendCurrency(int Price, int ItemID)
 	return pItem->Remove(Price);
 }
 
-void CPlayer::GiveEffect(const char* Potion, int Sec, float Chance)
+void CPlayer::GiveEffect(int EffectID, int Sec, float Chance)
 {
+	if(EffectID == EFFECT_NONE)
+		return;
+
 	if(m_pCharacter && m_pCharacter->IsAlive())
 	{
 		const float RandomChance = frandom() * 100.0f;
 		if(RandomChance < Chance)
 		{
-			GS()->Chat(m_ClientID, "You got the effect {STR} time {INT}sec.", Potion, Sec);
-			CGS::ms_aEffects[m_ClientID][Potion] = Sec;
+			GS()->Chat(m_ClientID, "You got the effect {STR} time {INT}sec.", CEffectRegistry::Get().Name(EffectID), Sec);
+			CGS::ms_aEffects[m_ClientID].Set(EffectID, Sec);
 		}
 	}
 }
 
-bool CPlayer::IsActiveEffect(const char* Potion) const
+bool CPlayer::IsActiveEffect(int EffectID) const
 {
-	return CGS::ms_aEffects[m_ClientID].find(Potion) != CGS::ms_aEffects[m_ClientID].end();
+	return CGS::ms_aEffects[m_ClientID].IsActive(EffectID);
 }
 
 void CPlayer::ClearEffects()
 {
-	CGS::ms_aEffects[m_ClientID].clear();
+	CGS::ms_aEffects[m_ClientID].Clear();
 }
 
 const char *CPlayer::GetLanguage() const
@@ -468,6 +465,11 @@ const char *CPlayer::GetLanguage() const
 	return Server()->GetClientLanguage(m_ClientID);
 }
 
+CLocalization::CLanguage* CPlayer::GetLanguageInfo() const
+{
+	return Server()->GetClientLanguageInfo(m_ClientID);
+}
+
 void CPlayer::UpdateTempData(int Health, int Mana)
 {
 	GetTempData().m_TempHealth = Health;
@@ -549,25 +551,45 @@ void CPlayer::FormatBroadcastBasicStats(char *pBuffer, int Size, const char* pAp
 	if(!IsAuthed() || !m_pCharacter)
 		return;
 
-	const int LevelPercent = translate_to_percent(ExpNeed(Acc().m_Level), Acc().m_Exp);
-	const std::unique_ptr<char[]> Level = std::move(GS()->LevelString(100, (int)LevelPercent, 10, ':', ' '));
-	const int MaximumHealth = GetStartHealth();
-	const int MaximumMana = GetStartMana();
-	const int Health = m_pCharacter->Health();
-	const int Mana = m_pCharacter->Mana();
-	const int Gold = GetItem(itGold)->GetValue();
+	int aValues[NUM_HUD_VALUES];
+	aValues[HUD_LEVEL] = Acc().m_Level;
+	aValues[HUD_LEVEL_PERCENT] = (int)translate_to_percent(ExpNeed(Acc().m_Level), Acc().m_Exp);
+	aValues[HUD_HEALTH] = m_pCharacter->Health();
+	aValues[HUD_MAX_HEALTH] = GetStartHealth();
+	aValues[HUD_MANA] = m_pCharacter->Mana();
+	aValues[HUD_MAX_MANA] = GetStartMana();
+	aValues[HUD_GOLD] = GetItem(itGold)->GetValue();
+	aValues[HUD_RECAST_SECONDS] = m_aPlayerTick[PotionRecast] > Server()->Tick() ? max(0, (m_aPlayerTick[PotionRecast] - Server()->Tick()) / Server()->TickSpeed()) : -1;
+
+	unsigned DirtyMask = m_HudValid ? 0 : ~0u;
+	for(int i = 0; i < NUM_HUD_VALUES; i++)
+	{
+		if(aValues[i] != m_aHudValues[i])
+			DirtyMask |= 1u << i;
+	}
 
-	char aRecastInfo[32]{};
-	if(m_aPlayerTick[PotionRecast] > Server()->Tick())
+	if(DirtyMask)
 	{
-		int Seconds = max(0, (m_aPlayerTick[PotionRecast] - Server()->Tick()) / Server()->TickSpeed());
-		str_format(aRecastInfo, sizeof(aRecastInfo), "Potion recast: %d", Seconds);
+		mem_copy(m_aHudValues, aValues, sizeof(m_aHudValues));
+		m_HudValid = true;
+
+		char aLevel[16];
+		GS()->LevelString(aLevel, sizeof(aLevel), 100, aValues[HUD_LEVEL_PERCENT], 10, ':', ' ');
+
+		char aRecastInfo[32]{};
+		if(aValues[HUD_RECAST_SECONDS] >= 0)
+			str_format(aRecastInfo, sizeof(aRecastInfo), "Potion recast: %d", aValues[HUD_RECAST_SECONDS]);
+
+		str_format(m_aHudText, sizeof(m_aHudText), "\n\n\n\n\nLv%d%s\nHP %d/%d\nMP %d/%d\nGold %d\n%s\n\n\n\n\n\n\n\n\n\n\n",
+			aValues[HUD_LEVEL], aLevel, aValues[HUD_HEALTH], aValues[HUD_MAX_HEALTH], aValues[HUD_MANA], aValues[HUD_MAX_MANA], aValues[HUD_GOLD], aRecastInfo);
 	}
 
-	str_format(pBuffer, Size, "\n\n\n\n\nLv%d%s\nHP %d/%d\nMP %d/%d\nGold %d\n%s\n\n\n\n\n\n\n\n\n\n\n%s", 
-		Acc().m_Level, Level.get(), Health, MaximumHealth, Mana, MaximumMana, Gold, aRecastInfo, pAppendStr);
-	for(int space = 150, c = str_length(pBuffer); c < Size && space; c++, space--)
-		pBuffer[c] = ' ';
+	str_copy(pBuffer, m_aHudText, Size);
+	str_append(pBuffer, pAppendStr, Size);
+	int Length = str_length(pBuffer);
+	for(int Space = 150; Length < Size - 1 && Space; Length++, Space--)
+		pBuffer[Length] = ' ';
+	pBuffer[Length] = '\0';
 }
 
 void CPlayer::ShowInformationStats()
@@ -636,6 +658,7 @@ bool CPlayer::ParseVoteUpgrades(const char *CMD, const int VoteID, const int Vot
 	{
 		if(Upgrade(Get, &Acc().m_aStats[(AttributeIdentifier)VoteID], &Acc().m_Upgrade, VoteID2, 1000))
 		{
+			InvalidateAttributes();
 			GS()->Mmo()->SaveAccount(this, SAVE_UPGRADES);
 			GS()->UpdateVotes(m_ClientID, MENU_UPGRADES);
 		}
@@ -720,6 +743,26 @@ int CPlayer::GetEquippedItemID(ItemFunctional EquipID, int SkipItemID) const
 }
 
 int CPlayer::GetAttributeSize(AttributeIdentifier ID, bool WorkedSize)
+{
+	if((int)ID < 0 || (int)ID >= (int)AttributeIdentifier::ATTRIBUTES_NUM)
+		return CalculateAttributeSize(ID, WorkedSize);
+
+	if(!m_AttributesCacheValid)
+	{
+		mem_zero(m_aAttributesCache, sizeof(m_aAttributesCache));
+		for(const auto& [AttributeID, pAttribute] : CAttributeDescription::Data())
+		{
+			if((int)AttributeID < 0 || (int)AttributeID >= (int)AttributeIdentifier::ATTRIBUTES_NUM)
+				continue;
+			m_aAttributesCache[(int)AttributeID][0] = CalculateAttributeSize(AttributeID, false);
+			m_aAttributesCache[(int)AttributeID][1] = CalculateAttributeSize(AttributeID, true);
+		}
+		m_AttributesCacheValid = true;
+	}
+	return m_aAttributesCache[(int)ID][WorkedSize];
+}
+
+int CPlayer::CalculateAttributeSize(AttributeIdentifier ID, bool WorkedSize)
 {
 	// if the best tank class is selected among the players we return the sync dungeon stats
 	const CAttributeDescription* pAtt = GS()->GetAttributeInfo(ID);
@@ -890,7 +933,12 @@ void CPlayer::SetTalking(int TalkedID, bool IsStartDialogue)
 			m_DialogNPC.m_RequestProgress = m_DialogNPC.m_Progress;
 			m_DialogNPC.m_FreezedProgress = true;
 
-			JsonTools::parseFromString(QuestBotInfo::ms_aQuestBot[MobID].m_EventJsonData, [this](nlohmann::json& pJson)
+			// the effect name is interned when the quest bots are loaded
+			const QuestBotInfo& QuestBot = QuestBotInfo::ms_aQuestBot[MobID];
+			if(QuestBot.m_EventEffectID != EFFECT_NONE)
+				GiveEffect(QuestBot.m_EventEffectID, QuestBot.m_EventEffectSeconds);
+
+			JsonTools::parseFromString(QuestBot.m_EventJsonData, [this](nlohmann::json& pJson)
 			{
 				/* * * * * * * *
 				 * Chat event
@@ -917,19 +965,6 @@ void CPlayer::SetTalking(int TalkedID, bool IsStartDialogue)
 					if(Highlighting)
 						GS()->Chat(m_ClientID, "*****************************");
 				}
-
-				/* * * * * * * *
-				 * Effect event
-				 * * * * * * * */
-				if(pJson.find("effect") != pJson.end())
-				{
-					auto pEffect = pJson["effect"];
-					std::string Effect = pEffect.value("name", "\0");
-					int Seconds = pEffect.value("seconds", 0);
-
-					if(!Effect.empty())
-						GiveEffect(Effect.c_str(), Seconds);
-				}
 			});
 
 			return;
@@ -961,7 +996,7 @@ void CPlayer::FormatDialogText(int DataBotID, const char *pText) // TODO: perfor
 	if(!DataBotInfo::IsDataBotValid(DataBotID) || m_aFormatDialogText[0] != '\0')
 		return;
 
-	str_copy(m_aFormatDialogText, GS()->Server()->Localization()->Localize(GetLanguage(), pText), sizeof(m_aFormatDialogText));
+	str_copy(m_aFormatDialogText, GS()->Server()->Localization()->Localize(GetLanguageInfo(), pText), sizeof(m_aFormatDialogText));
 
 	// arrays replacing dialogs
 	const char* pSearch = str_find(m_aFormatDialogText, "<bot_");
@@ -7,6 +7,7 @@
 #include "mmocore/Components/Inventory/ItemData.h"
 #include "mmocore/Components/Quests/QuestData.h"
 #include "mmocore/Components/Skills/SkillData.h"
+#include "mmocore/Utils/Effects.h"
 
 #include <game/voting.h>
 #include "entities/character.h"
@@ -47,6 +48,28 @@ class CPlayer
 	int m_SnapHealthTick;
 	std::unordered_map < int, bool > m_aHiddenMenu;
 
+	// attribute totals by [ID][WorkedSize], rebuilt after InvalidateAttributes
+	int m_aAttributesCache[(int)AttributeIdentifier::ATTRIBUTES_NUM][2];
+	bool m_AttributesCacheValid;
+	int CalculateAttributeSize(AttributeIdentifier ID, bool WorkedSize);
+
+	// basic stats text, formatted again only when one of its values changed
+	enum
+	{
+		HUD_LEVEL = 0,
+		HUD_LEVEL_PERCENT,
+		HUD_HEALTH,
+		HUD_MAX_HEALTH,
+		HUD_MANA,
+		HUD_MAX_MANA,
+		HUD_GOLD,
+		HUD_RECAST_SECONDS,
+		NUM_HUD_VALUES
+	};
+	int m_aHudValues[NUM_HUD_VALUES];
+	char m_aHudText[256];
+	bool m_HudValid;
+
 protected:
 	CCharacter* m_pCharacter;
 	CGS* m_pGS;
@@ -106,10 +129,12 @@ public:
 	virtual int IsVisibleForClient(int ClientID) const { return 2; }
 	virtual int GetEquippedItemID(ItemFunctional EquipID, int SkipItemID = -1) const;
 	virtual int GetAttributeSize(AttributeIdentifier ID, bool WorkedSize = false);
+	// call when equipment, enchants, upgrades or the dungeon sync of the player change
+	void InvalidateAttributes() { m_AttributesCacheValid = false; }
 	virtual void UpdateTempData(int Health, int Mana);
 
-	virtual void GiveEffect(const char* Potion, int Sec, float Chance = 100.0f);
-	virtual bool IsActiveEffect(const char* Potion) const;
+	virtual void GiveEffect(int EffectID, int Sec, float Chance = 100.0f);
+	virtual bool IsActiveEffect(int EffectID) const;
 	virtual void ClearEffects();
 
 	virtual void Tick();
@@ -147,6 +172,7 @@ public:
 	######################################################################### */
 	bool SpendCurrency(int Price, int ItemID = 1);
 	const char* GetLanguage() const;
+	CLocalization::CLanguage* GetLanguageInfo() const;
 	void AddExp(int Exp);
 	void AddMoney(int Money);
 
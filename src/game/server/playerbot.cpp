@@ -92,19 +92,10 @@ CPlayer* CPlayerBot::GetEidolonOwner() const
 
 void CPlayerBot::EffectsTick()
 {
-	if(Server()->Tick() % Server()->TickSpeed() != 0)
+	if(Server()->Tick() % Server()->TickSpeed() != 0 || m_Effects.Empty())
 		return;
 
-	for(auto pEffect = m_aEffects.begin(); pEffect != m_aEffects.end();)
-	{
-		pEffect->second--;
-		if(pEffect->second <= 0)
-		{
-			pEffect = m_aEffects.erase(pEffect);
-			continue;
-		}
-		++pEffect;
-	}
+	m_Effects.Tick([](int) {});
 }
 
 int CPlayerBot::GetRespawnTick() const
@@ -164,24 +155,24 @@ int CPlayerBot::GetAttributeSize(AttributeIdentifier ID, bool WorkedSize)
 	return Size;
 }
 
-void CPlayerBot::GiveEffect(const char* Potion, int Sec, float Chance)
+void CPlayerBot::GiveEffect(int EffectID, int Sec, float Chance)
 {
-	if(!m_pCharacter || !m_pCharacter->IsAlive())
+	if(EffectID == EFFECT_NONE || !m_pCharacter || !m_pCharacter->IsAlive())
 		return;
 
 	const float RandomChance = frandom() * 100.0f;
 	if(RandomChance < Chance)
-		m_aEffects[Potion] = Sec;
+		m_Effects.Set(EffectID, Sec);
 }
 
-bool CPlayerBot::IsActiveEffect(const char* Potion) const
+bool CPlayerBot::IsActiveEffect(int EffectID) const
 {
-	return m_aEffects.find(Potion) != m_aEffects.end();
+	return m_Effects.IsActive(EffectID);
 }
 
 void CPlayerBot::ClearEffects()
 {
-	m_aEffects.clear();
+	m_Effects.Clear();
 }
 
 void CPlayerBot::TryRespawn()
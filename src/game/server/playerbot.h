@@ -55,8 +55,8 @@ public:
 	int GetEquippedItemID(ItemFunctional EquipID, int SkipItemID = -1) const override;
 	int GetAttributeSize(AttributeIdentifier ID, bool WorkedSize = false) override;
 
-	void GiveEffect(const char* Potion, int Sec, float Chance = 100.0f) override;
-	bool IsActiveEffect(const char* Potion) const override;
+	void GiveEffect(int EffectID, int Sec, float Chance = 100.0f) override;
+	bool IsActiveEffect(int EffectID) const override;
 	void ClearEffects() override;
 
 	void Tick() override;
@@ -70,7 +70,7 @@ public:
 	class CPlayer* GetEidolonOwner() const;
 
 private:
-	std::unordered_map < std::string /* effect */, int /* seconds */ > m_aEffects;
+	CEffectTimers m_Effects;
 	void EffectsTick() override;
 	int GetRespawnTick() const;
 	void TryRespawn() override;
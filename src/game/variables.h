@@ -108,6 +108,9 @@ MACRO_CONFIG_INT(SvInactiveKick, sv_inactivekick, 2, 0, 3, CFGFLAG_SERVER, "How
 // another config
 MACRO_CONFIG_INT(SvPriceTeleport, sv_price_teleport, 12, 0, 10000, CFGFLAG_SERVER, "Price for teleport*WorldID")
 MACRO_CONFIG_INT(SvDoorRadiusHit, sv_door_radius_hit, 16, 16, 1000, CFGFLAG_SERVER, "Door radius hit.")
+MACRO_CONFIG_INT(SvNicknameCacheSize, sv_nickname_cache_size, 2048, 64, 100000, CFGFLAG_SERVER, "Offline account nicknames kept in memory (takes effect on restart)")
+MACRO_CONFIG_INT(SvQuestSaveInterval, sv_quest_save_interval, 60, 5, 3600, CFGFLAG_SERVER, "Seconds between writes of the changed quest steps progress")
+MACRO_CONFIG_INT(SvVoteMenuThreads, sv_vote_menu_threads, 2, 1, 8, CFGFLAG_SERVER, "Threads rendering the vote menus (takes effect on restart)")
 
 // auction
 MACRO_CONFIG_INT(SvMaxAuctionSlots, sv_amax_slots, 5, 1, 1000, CFGFLAG_SERVER, "Max autction slots")
@@ -159,9 +162,13 @@ MACRO_CONFIG_STR(SvMySqlLogin, sv_sql_login, 32, "root", CFGFLAG_SERVER, "MySQL
 MACRO_CONFIG_STR(SvMySqlPassword, sv_sql_password, 32, "", CFGFLAG_SERVER, "MySQL Password")
 MACRO_CONFIG_INT(SvMySqlPort, sv_sql_port, 3306, 0, 65000, CFGFLAG_SERVER, "MySQL Port")
 MACRO_CONFIG_INT(SvMySqlPoolSize, sv_sql_pool_size, 3, 1, 12, CFGFLAG_SERVER, "MySQL Pool size");
+MACRO_CONFIG_INT(SvMySqlSlowQuery, sv_sql_slow_query, 100, 0, 60000, CFGFLAG_SERVER, "Log queries that take longer than this many milliseconds (0 = off)")
+MACRO_CONFIG_INT(SvMySqlStatsDumpInterval, sv_sql_stats_dump_interval, 0, 0, 3600, CFGFLAG_SERVER, "Write SQL statistics every n seconds (0 = off)")
+MACRO_CONFIG_STR(SvMySqlStatsDumpFile, sv_sql_stats_dump_file, 128, "sql_stats.json", CFGFLAG_SERVER, "File the SQL statistics are written to")
 
 MACRO_CONFIG_INT(SvLoltextHspace, sv_loltext_hspace, 7, 7, 25, CFGFLAG_SERVER, "horizontal offset between loltext 'pixels'")
 MACRO_CONFIG_INT(SvLoltextVspace, sv_loltext_vspace, 7, 7, 25, CFGFLAG_SERVER, "vertical offset between loltext 'pixels'")
+MACRO_CONFIG_INT(SvLoltextMaxPerWorld, sv_loltext_max_per_world, 48, 1, 1000, CFGFLAG_SERVER, "Max loltexts shown at the same time in one world")
 
 // ui
 MACRO_CONFIG_INT(ClNotifyWindow, cl_notify_window, 1, 0, 1, CFGFLAG_CLIENT | CFGFLAG_SAVE, "Allow client to notify you on chat highlights")
@@ -4,32 +4,20 @@
 
 #include "localization.h"
 
-CLocalization::CLanguage::CLanguage() : m_Loaded(false), m_Direction(CLocalization::DIRECTION_LTR)
+CLocalization::CLanguage::CLanguage() : m_Loaded(false), m_Direction(CLocalization::DIRECTION_LTR), m_pParent(nullptr)
 {
 	m_aName[0] = 0;
 	m_aFilename[0] = 0;
 	m_aParentFilename[0] = 0;
 }
 
-CLocalization::CLanguage::CLanguage(const char* pName, const char* pFilename, const char* pParentFilename) : m_Loaded(false), m_Direction(CLocalization::DIRECTION_LTR)
+CLocalization::CLanguage::CLanguage(const char* pName, const char* pFilename, const char* pParentFilename) : m_Loaded(false), m_Direction(CLocalization::DIRECTION_LTR), m_pParent(nullptr)
 {
 	str_copy(m_aName, pName, sizeof(m_aName));
 	str_copy(m_aFilename, pFilename, sizeof(m_aFilename));
 	str_copy(m_aParentFilename, pParentFilename, sizeof(m_aParentFilename));
 }
 
-CLocalization::CLanguage::~CLanguage()
-{
-	hashtable< CEntry, 128 >::iterator Iter = m_Translations.begin();
-	while(Iter != m_Translations.end())
-	{
-		if(Iter.data())
-			Iter.data()->Free();
-
-		++Iter;
-	}
-}
-
 bool CLocalization::CLanguage::Load(CLocalization* pLocalization, IStorageEngine* pStorage)
 {
 	// read file data into buffer
@@ -57,28 +45,18 @@ bool CLocalization::CLanguage::Load(CLocalization* pLocalization, IStorageEngine
 		return false;
 	}
 
-	dynamic_string Buffer;
-	int Length;
-
 	// extract data
 	const json_value& rStart = (*pJsonData)["translation"];
 	if(rStart.type == json_array)
 	{
+		m_Translations.reserve(rStart.u.array.length, FileSize);
 		for(unsigned i = 0; i < rStart.u.array.length; ++i)
 		{
+			// entries without a value are left to the parent language
 			const char* pKey = rStart[i]["key"];
-			if(pKey && pKey[0])
-			{
-				CEntry* pEntry = m_Translations.set(pKey);
-
-				const char* pSingular = rStart[i]["value"];
-				if(pSingular && pSingular[0])
-				{
-					Length = str_length(pSingular) + 1;
-					pEntry->m_apVersions = new char[Length];
-					str_copy(pEntry->m_apVersions, pSingular, Length);
-				}
-			}
+			const char* pSingular = rStart[i]["value"];
+			if(pKey && pKey[0] && pSingular && pSingular[0])
+				m_Translations.set(pKey, pSingular);
 		}
 	}
 
@@ -91,11 +69,7 @@ bool CLocalization::CLanguage::Load(CLocalization* pLocalization, IStorageEngine
 
 const char* CLocalization::CLanguage::Localize(const char* pText) const
 {
-	const CEntry* pEntry = m_Translations.get(pText);
-	if(!pEntry)
-		return nullptr;
-
-	return pEntry->m_apVersions;
+	return m_Translations.get(pText);
 }
 
 CLocalization::CLocalization(IStorageEngine* pStorage) : m_pStorage(pStorage), m_pMainLanguage(nullptr)
@@ -156,174 +130,241 @@ bool CLocalization::Init()
 		}
 	}
 
+	// resolve parents once, unknown ones fall back to the main language like before
+	for(int i = 0; i < m_pLanguages.size(); i++)
+	{
+		if(m_pLanguages[i]->GetParentFilename()[0])
+			m_pLanguages[i]->SetParent(GetLanguage(m_pLanguages[i]->GetParentFilename()));
+	}
+
 	// clean up
 	json_value_free(pJsonData);
 	return true;
 }
 
-const char* CLocalization::LocalizeWithDepth(const char* pLanguageCode, const char* pText, int Depth)
+CLocalization::CLanguage* CLocalization::GetLanguage(const char* pLanguageCode) const
 {
-	CLanguage* pLanguage = m_pMainLanguage;
 	if(pLanguageCode)
 	{
 		for(int i = 0; i < m_pLanguages.size(); i++)
 		{
 			if(str_comp(m_pLanguages[i]->GetFilename(), pLanguageCode) == 0)
-			{
-				pLanguage = m_pLanguages[i];
-				break;
-			}
+				return m_pLanguages[i];
 		}
 	}
+	return m_pMainLanguage;
+}
 
-	if(!pLanguage)
-		return pText;
+const char* CLocalization::Localize(CLanguage* pLanguage, const char* pText)
+{
+	for(int Depth = 0; pLanguage && Depth <= 4; Depth++)
+	{
+		if(!pLanguage->IsLoaded())
+			pLanguage->Load(this, Storage());
 
-	if(!pLanguage->IsLoaded())
-		pLanguage->Load(this, Storage());
+		if(const char* pResult = pLanguage->Localize(pText))
+			return pResult;
 
-	const char* pResult = pLanguage->Localize(pText);
-	if(pResult)
-		return pResult;
-	if(pLanguage->GetParentFilename()[0] && Depth < 4)
-		return LocalizeWithDepth(pLanguage->GetParentFilename(), pText, Depth + 1);
+		pLanguage = pLanguage->GetParent();
+	}
 	return pText;
 }
 
-const char* CLocalization::Localize(const char* pLanguageCode, const char* pText)
+// formats without allocating, the separator is put between groups of three digits if set
+static int format_integer(char* pBuffer, int Value, char Separator)
 {
-	return LocalizeWithDepth(pLanguageCode, pText, 0);
+	char aDigits[16];
+	int NumDigits = 0;
+	unsigned Abs = Value < 0 ? 0u - (unsigned)Value : (unsigned)Value;
+	do
+	{
+		aDigits[NumDigits++] = (char)('0' + Abs % 10);
+		Abs /= 10;
+	} while(Abs);
+
+	int Length = 0;
+	if(Value < 0)
+		pBuffer[Length++] = '-';
+	for(int i = NumDigits - 1; i >= 0; i--)
+	{
+		pBuffer[Length++] = aDigits[i];
+		if(Separator && i > 0 && i % 3 == 0)
+			pBuffer[Length++] = Separator;
+	}
+	pBuffer[Length] = 0;
+	return Length;
 }
 
-static char* format_integer_with_commas(char commas, int n)
+void CLocalization::CFormatTemplate::Compile(const char* pText)
 {
-	char _number_array[64] = { '\0' };
-	str_format(_number_array, sizeof(_number_array), "%d", n); // %ll
-
-	const char* _number_pointer = _number_array;
-	int _number_of_digits = 0;
-	while (*(_number_pointer + _number_of_digits++));
-	--_number_of_digits;
-
-	/*
-	*	count the number of digits
-	*	calculate the position for the first comma separator
-	*	calculate the final length of the number with commas
-	*
-	*	the starting position is a repeating sequence 123123... which depends on the number of digits
-	*	the length of the number with commas is the sequence 111222333444...
-	*/
-	const int _starting_separator_position = _number_of_digits < 4 ? 0 : _number_of_digits % 3 == 0 ? 3 : _number_of_digits % 3;
-	const int _formatted_number_length = _number_of_digits + _number_of_digits / 3 - (_number_of_digits % 3 == 0 ? 1 : 0);
-
-	// create formatted number array based on calculated information.
-	char* _formatted_number = new char[20 * 3 + 1];
-
-	// place all the commas
-	for (int i = _starting_separator_position; i < _formatted_number_length - 3; i += 4)
-		_formatted_number[i] = commas;
-
-	// place the digits
-	for (int i = 0, j = 0; i < _formatted_number_length; i++)
-		if (_formatted_number[i] != commas)
-			_formatted_number[i] = _number_pointer[j++];
-
-	/* close the string */
-	_formatted_number[_formatted_number_length] = '\0';
-	return _formatted_number;
-}
+	m_Source = pText;
+	m_aSegments.clear();
 
-void CLocalization::Format_V(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs)
-{
-	CLanguage* pLanguage = m_pMainLanguage;
-	if(pLanguageCode)
+	// same parsing rules as before: a parameter runs to the next '}', unknown types are dropped
+	// and an unclosed parameter drops the rest of the text
+	int Iter = 0;
+	int Start = 0;
+	int ParamTypeStart = -1;
+	while(pText[Iter])
 	{
-		for(int i = 0; i < m_pLanguages.size(); i++)
+		if(ParamTypeStart >= 0)
 		{
-			if(str_comp(m_pLanguages[i]->GetFilename(), pLanguageCode) != 0)
+			if(pText[Iter] != '}')
+			{
+				Iter = str_utf8_forward(pText, Iter);
 				continue;
+			}
+
+			if(str_comp_num("STR", pText + ParamTypeStart, 3) == 0)
+				m_aSegments.push_back({ SEGMENT_STR, 0, 0 });
+			else if(str_comp_num("INT", pText + ParamTypeStart, 3) == 0)
+				m_aSegments.push_back({ SEGMENT_INT, 0, 0 });
+			else if(str_comp_num("VAL", pText + ParamTypeStart, 3) == 0)
+				m_aSegments.push_back({ SEGMENT_VAL, 0, 0 });
 
-			pLanguage = m_pLanguages[i];
-			break;
+			Start = Iter + 1;
+			ParamTypeStart = -1;
+		}
+		else if(pText[Iter] == '{')
+		{
+			if(Iter > Start)
+				m_aSegments.push_back({ SEGMENT_TEXT, Start, Iter - Start });
+			Iter++;
+			ParamTypeStart = Iter;
 		}
+
+		Iter = str_utf8_forward(pText, Iter);
 	}
 
+	if(ParamTypeStart == -1 && Iter > Start)
+		m_aSegments.push_back({ SEGMENT_TEXT, Start, Iter - Start });
+}
+
+std::shared_ptr<const CLocalization::CFormatTemplate> CLocalization::CLanguage::FindFormat(uint64_t Hash, const char* pText)
+{
+	std::lock_guard<std::mutex> Lock(m_FormatCacheMutex);
+	const auto Iter = m_aFormatCache.find(Hash);
+	if(Iter == m_aFormatCache.end() || Iter->second.m_pTemplate->m_Source != pText)
+		return nullptr;
+
+	Iter->second.m_Referenced = true;
+	return Iter->second.m_pTemplate;
+}
+
+void CLocalization::CLanguage::CacheFormat(uint64_t Hash, const std::shared_ptr<const CFormatTemplate>& pTemplate)
+{
+	std::lock_guard<std::mutex> Lock(m_FormatCacheMutex);
+
+	// a colliding text takes over the slot
+	const auto Iter = m_aFormatCache.find(Hash);
+	if(Iter != m_aFormatCache.end())
+	{
+		Iter->second = { pTemplate, false };
+		return;
+	}
+
+	// one pass at most, every skipped entry loses its mark
+	while((int)m_aFormatCache.size() >= MAX_FORMAT_CACHE)
+	{
+		const uint64_t Oldest = m_aFormatCacheOrder.front();
+		m_aFormatCacheOrder.pop_front();
+
+		CCachedFormat& Entry = m_aFormatCache[Oldest];
+		if(Entry.m_Referenced)
+		{
+			Entry.m_Referenced = false;
+			m_aFormatCacheOrder.push_back(Oldest);
+			continue;
+		}
+		m_aFormatCache.erase(Oldest);
+	}
+
+	m_aFormatCache.emplace(Hash, CCachedFormat{ pTemplate, false });
+	m_aFormatCacheOrder.push_back(Hash);
+}
+
+int CLocalization::CLanguage::NumCachedFormats()
+{
+	std::lock_guard<std::mutex> Lock(m_FormatCacheMutex);
+	return (int)m_aFormatCache.size();
+}
+
+void CLocalization::Format_V(dynamic_string& Buffer, CLanguage* pLanguage, const char* pText, va_list VarArgs)
+{
 	if(!pLanguage)
 	{
 		Buffer.append(pText);
 		return;
 	}
 
-	// start parameters of the end of the name and type string
-	const int BufferStart = Buffer.length();
-	int BufferIter = BufferStart;
-	int ParamTypeStart = -1;
+	// 64-bit FNV-1a over the text, texts without parameters are already final (names, prebuilt lines)
+	// and are not cached
+	uint64_t Hash = 14695981039346656037ull;
+	bool HasParams = false;
+	for(const char* p = pText; *p; p++)
+	{
+		Hash = (Hash ^ (unsigned char)*p) * 1099511628211ull;
+		HasParams |= *p == '{';
+	}
+	if(!HasParams)
+	{
+		Buffer.append(pText);
+		return;
+	}
+
+	// votes are formatted from threads too, the lock only covers the lookup and the insert
+	std::shared_ptr<const CFormatTemplate> pTemplate = pLanguage->FindFormat(Hash, pText);
+	if(!pTemplate)
+	{
+		std::shared_ptr<CFormatTemplate> pCompiled = std::make_shared<CFormatTemplate>();
+		pCompiled->Compile(pText);
+		pTemplate = pCompiled;
+		pLanguage->CacheFormat(Hash, pTemplate);
+	}
+	const CFormatTemplate& Template = *pTemplate;
 
-	// argument parsing
 	va_list VarArgsIter;
 	va_copy(VarArgsIter, VarArgs);
 
-	// character positions
-	int Iter = 0;
-	int Start = 0;
-
-	// parse text to search for positions
-	while(pText[Iter])
+	char aNumber[32];
+	int BufferIter = Buffer.length();
+	const char* pSource = Template.m_Source.c_str();
+	for(const CFormatTemplate::CSegment& Segment : Template.m_aSegments)
 	{
-		if(ParamTypeStart >= 0)
+		switch(Segment.m_Type)
 		{
-			if(pText[Iter] != '}')
-			{
-				Iter = str_utf8_forward(pText, Iter);
-				continue;
-			}
-
-			// we get data from an argument parsing arguments
-			if(str_comp_num("STR", pText + ParamTypeStart, 3) == 0) // string
+			case CFormatTemplate::SEGMENT_TEXT:
+				BufferIter = Buffer.append_at_num(BufferIter, pSource + Segment.m_Start, Segment.m_Length);
+				break;
+			case CFormatTemplate::SEGMENT_STR:
 			{
 				const char* pVarArgValue = va_arg(VarArgsIter, const char*);
 				const char* pTranslatedValue = pLanguage->Localize(pVarArgValue);
 				BufferIter = Buffer.append_at(BufferIter, (pTranslatedValue ? pTranslatedValue : pVarArgValue));
+				break;
 			}
-			else if(str_comp_num("INT", pText + ParamTypeStart, 3) == 0) // intiger
-			{
-				char aBuf[128];
-				const int pVarArgValue = va_arg(VarArgsIter, int);
-				str_format(aBuf, sizeof(aBuf), "%d", pVarArgValue); // %ll
-				BufferIter = Buffer.append_at(BufferIter, aBuf);
-			}
-			else if(str_comp_num("VAL", pText + ParamTypeStart, 3) == 0) // value
-			{
-				const int pVarArgValue = va_arg(VarArgsIter, int);
-				char* aBuffer = format_integer_with_commas(',', pVarArgValue);
-				BufferIter = Buffer.append_at(BufferIter, aBuffer);
-				delete[] aBuffer;
-			}
-
-			//
-			Start = Iter + 1;
-			ParamTypeStart = -1;
-		}
-
-		// parameter parsing start
-		else
-		{
-			if(pText[Iter] == '{')
-			{
-				BufferIter = Buffer.append_at_num(BufferIter, pText + Start, Iter - Start);
-				Iter++;
-				ParamTypeStart = Iter;
-			}
+			case CFormatTemplate::SEGMENT_INT:
+				format_integer(aNumber, va_arg(VarArgsIter, int), 0);
+				BufferIter = Buffer.append_at(BufferIter, aNumber);
+				break;
+			case CFormatTemplate::SEGMENT_VAL:
+				format_integer(aNumber, va_arg(VarArgsIter, int), ',');
+				BufferIter = Buffer.append_at(BufferIter, aNumber);
+				break;
 		}
-
-		Iter = str_utf8_forward(pText, Iter);
 	}
 
-	// close the argument macro
 	va_end(VarArgsIter);
+}
+
+void CLocalization::Format(dynamic_string& Buffer, CLanguage* pLanguage, const char* pText, ...)
+{
+	va_list VarArgs;
+	va_start(VarArgs, pText);
+
+	Format_V(Buffer, pLanguage, pText, VarArgs);
 
-	if(Iter > 0 && ParamTypeStart == -1)
-		Buffer.append_at_num(BufferIter, pText + Start, Iter - Start);
+	va_end(VarArgs);
 }
 
 void CLocalization::Format(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, ...)
@@ -336,11 +377,21 @@ void CLocalization::Format(dynamic_string& Buffer, const char* pLanguageCode, co
 	va_end(VarArgs);
 }
 
-void CLocalization::Format_VL(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs)
+void CLocalization::Format_VL(dynamic_string& Buffer, CLanguage* pLanguage, const char* pText, va_list VarArgs)
 {
-	const char* pLocalText = Localize(pLanguageCode, pText);
+	const char* pLocalText = Localize(pLanguage, pText);
 
-	Format_V(Buffer, pLanguageCode, pLocalText, VarArgs);
+	Format_V(Buffer, pLanguage, pLocalText, VarArgs);
+}
+
+void CLocalization::Format_L(dynamic_string& Buffer, CLanguage* pLanguage, const char* pText, ...)
+{
+	va_list VarArgs;
+	va_start(VarArgs, pText);
+
+	Format_VL(Buffer, pLanguage, pText, VarArgs);
+
+	va_end(VarArgs);
 }
 
 void CLocalization::Format_L(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, ...)
@@ -1,7 +1,18 @@
 #ifndef TEEOTHER_COMPONENTS_LOCALIZATION_H
 #define TEEOTHER_COMPONENTS_LOCALIZATION_H
 
-#include <teeother/tl/hashtable.h>
+#include <base/tl/array.h>
+#include <teeother/system/string.h>
+#include <teeother/tl/string_hashtable.h>
+
+#include <cstdarg>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 /*
  * TODO: Add plural rules example {RP:{INT}:{STR}} or {PR:{INT}:player} use rules from lang files
@@ -14,45 +25,72 @@ class CLocalization
 
 public:
 
-	class CLanguage
+	// template text split once into literal runs and argument slots
+	class CFormatTemplate
 	{
-	protected:
-		class CEntry
+	public:
+		enum
+		{
+			SEGMENT_TEXT = 0,
+			SEGMENT_STR,
+			SEGMENT_INT,
+			SEGMENT_VAL,
+		};
+
+		struct CSegment
 		{
-		public:
-			char* m_apVersions;
-
-			CEntry() : m_apVersions(nullptr) {}
-
-			void Free()
-			{
-				if (m_apVersions)
-				{
-					delete[] m_apVersions;
-					m_apVersions = nullptr;
-				}
-			}
+			int m_Type;
+			int m_Start;
+			int m_Length;
 		};
 
+		std::string m_Source;
+		std::vector<CSegment> m_aSegments;
+
+		void Compile(const char* pText);
+	};
+
+	class CLanguage
+	{
+		friend class CLocalization;
+
+	protected:
 		char m_aName[64];
 		char m_aFilename[64];
 		char m_aParentFilename[64];
 		bool m_Loaded;
 		int m_Direction;
+		CLanguage* m_pParent;
+
+		string_hashtable m_Translations;
+
+		// compiled templates by a hash of the text, the source is checked on a hit. a full cache evicts
+		// in insertion order and gives a second chance to entries hit since they were last passed over
+		struct CCachedFormat
+		{
+			std::shared_ptr<const CFormatTemplate> m_pTemplate;
+			bool m_Referenced;
+		};
+		std::unordered_map<uint64_t, CCachedFormat> m_aFormatCache;
+		std::deque<uint64_t> m_aFormatCacheOrder;
+		std::mutex m_FormatCacheMutex;
 
-		hashtable< CEntry, 128 > m_Translations;
+		std::shared_ptr<const CFormatTemplate> FindFormat(uint64_t Hash, const char* pText);
+		void CacheFormat(uint64_t Hash, const std::shared_ptr<const CFormatTemplate>& pTemplate);
 
 	public:
 		CLanguage();
 		CLanguage(const char* pName, const char* pFilename, const char* pParentFilename);
-		~CLanguage();
 
+		void SetParent(CLanguage* pParent) { m_pParent = pParent; }
+		CLanguage* GetParent() const { return m_pParent; }
 		const char* GetParentFilename() const { return m_aParentFilename; }
 		const char* GetFilename() const { return m_aFilename; }
 		const char* GetName() const { return m_aName; }
 		bool IsLoaded() const { return m_Loaded; }
 		bool Load(CLocalization* pLocalization, IStorageEngine* pStorage);
 		const char* Localize(const char* pKey) const;
+		int NumCachedFormats();
 	};
 
 	enum
@@ -60,6 +98,8 @@ public:
 		DIRECTION_LTR=0,
 		DIRECTION_RTL,
 		NUM_DIRECTIONS,
+
+		MAX_FORMAT_CACHE=4096,
 	};
 
 protected:
@@ -69,9 +109,6 @@ public:
 	array<CLanguage*> m_pLanguages;
 	fixed_string128 m_Cfg_MainLanguage;
 
-protected:
-	const char* LocalizeWithDepth(const char* pLanguageCode, const char* pText, int Depth);
-
 public:
 	CLocalization(IStorageEngine* pStorage);
 	virtual ~CLocalization();
@@ -79,14 +116,22 @@ public:
 	virtual bool InitConfig(int argc, const char** argv);
 	virtual bool Init();
 
+	// language by code, the main language if the code is unknown (keep the pointer instead of looking it up for each message)
+	CLanguage* GetLanguage(const char* pLanguageCode) const;
+
 	//localize
-	const char* Localize(const char* pLanguageCode, const char* pText);
+	const char* Localize(CLanguage* pLanguage, const char* pText);
+	const char* Localize(const char* pLanguageCode, const char* pText) { return Localize(GetLanguage(pLanguageCode), pText); }
 
 	//format
-	void Format_V(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs);
+	void Format_V(dynamic_string& Buffer, CLanguage* pLanguage, const char* pText, va_list VarArgs);
+	void Format_V(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs) { Format_V(Buffer, GetLanguage(pLanguageCode), pText, VarArgs); }
+	void Format(dynamic_string& Buffer, CLanguage* pLanguage, const char* pText, ...);
 	void Format(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, ...);
 	//localize, format
-	void Format_VL(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs);
+	void Format_VL(dynamic_string& Buffer, CLanguage* pLanguage, const char* pText, va_list VarArgs);
+	void Format_VL(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs) { Format_VL(Buffer, GetLanguage(pLanguageCode), pText, VarArgs); }
+	void Format_L(dynamic_string& Buffer, CLanguage* pLanguage, const char* pText, ...);
 	void Format_L(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, ...);
 };
 
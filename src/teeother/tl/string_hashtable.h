@@ -0,0 +1,137 @@
+#ifndef SHARED_TL_STRING_HASHTABLE_H
+#define SHARED_TL_STRING_HASHTABLE_H
+
+#include <base/system.h>
+
+#include <vector>
+
+/*
+	Class: string_hashtable
+		String to string table with open addressing (linear probing).
+		Keys and values are copied into one contiguous buffer, the slots
+		keep the full hash so probing rarely needs a string compare.
+*/
+class string_hashtable
+{
+	typedef unsigned int HASH;
+
+	struct slot
+	{
+		HASH m_Hash;
+		int m_Key; // offset in m_aData, -1 for an empty slot
+		int m_Value;
+	};
+
+	std::vector<slot> m_aSlots;
+	std::vector<char> m_aData;
+	int m_Num;
+
+	static HASH hash(const char* pKey)
+	{
+		// FNV-1a
+		HASH Hash = 2166136261u;
+		for(; *pKey; pKey++)
+			Hash = (Hash ^ (unsigned char)*pKey) * 16777619u;
+		return Hash;
+	}
+
+	int store(const char* pStr)
+	{
+		const int Offset = (int)m_aData.size();
+		const int Length = str_length(pStr) + 1;
+		m_aData.insert(m_aData.end(), pStr, pStr + Length);
+		return Offset;
+	}
+
+	int find_slot(const char* pKey, HASH Hash) const
+	{
+		const int Mask = (int)m_aSlots.size() - 1;
+		for(int i = (int)(Hash & Mask);; i = (i + 1) & Mask)
+		{
+			const slot& Slot = m_aSlots[i];
+			if(Slot.m_Key < 0 || (Slot.m_Hash == Hash && str_comp(&m_aData[Slot.m_Key], pKey) == 0))
+				return i;
+		}
+	}
+
+	void grow()
+	{
+		std::vector<slot> aOld;
+		aOld.swap(m_aSlots);
+		m_aSlots.assign(aOld.empty() ? 64 : aOld.size() * 2, slot{ 0, -1, -1 });
+
+		const int Mask = (int)m_aSlots.size() - 1;
+		for(const slot& Slot : aOld)
+		{
+			if(Slot.m_Key < 0)
+				continue;
+
+			int i = (int)(Slot.m_Hash & Mask);
+			while(m_aSlots[i].m_Key >= 0)
+				i = (i + 1) & Mask;
+			m_aSlots[i] = Slot;
+		}
+	}
+
+public:
+	string_hashtable() : m_Num(0) {}
+
+	/*
+		Function: clear
+			Removes all entries and frees the storage
+	*/
+	void clear()
+	{
+		std::vector<slot>().swap(m_aSlots);
+		std::vector<char>().swap(m_aData);
+		m_Num = 0;
+	}
+
+	/*
+		Function: reserve
+			Prepares the table for the given number of entries
+	*/
+	void reserve(int Num, int DataSize = 0)
+	{
+		while((int)m_aSlots.size() < Num * 2)
+			grow();
+		m_aData.reserve(DataSize);
+	}
+
+	/*
+		Function: set
+			Adds an entry or replaces the value of an existing key
+	*/
+	void set(const char* pKey, const char* pValue)
+	{
+		if((m_Num + 1) * 2 > (int)m_aSlots.size())
+			grow();
+
+		const HASH Hash = hash(pKey);
+		slot& Slot = m_aSlots[find_slot(pKey, Hash)];
+		if(Slot.m_Key < 0)
+		{
+			Slot.m_Hash = Hash;
+			Slot.m_Key = store(pKey);
+			m_Num++;
+		}
+		Slot.m_Value = store(pValue);
+	}
+
+	/*
+		Function: get
+			Returns the value of the key or nullptr
+	*/
+	const char* get(const char* pKey) const
+	{
+		if(m_Num == 0)
+			return nullptr;
+
+		const slot& Slot = m_aSlots[find_slot(pKey, hash(pKey))];
+		return Slot.m_Key < 0 ? nullptr : &m_aData[Slot.m_Value];
+	}
+
+	int size() const { return m_Num; }
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <game/server/alloc.h>
+
+class CPooledObject
+{
+	MACRO_ALLOC_POOL()
+
+public:
+	int m_aData[8];
+};
+
+MACRO_ALLOC_POOL_IMPL(CPooledObject, 4)
+
+static const CAllocPool* FindPool(const char* pName)
+{
+	for(const CAllocPool* pPool = CAllocPool::First(); pPool; pPool = pPool->Next())
+	{
+		if(str_comp(pPool->Name(), pName) == 0)
+			return pPool;
+	}
+	return nullptr;
+}
+
+TEST(AllocPool, LivePeak)
+{
+	const CAllocPool* pPool = FindPool("CPooledObject");
+	ASSERT_TRUE(pPool);
+
+	CPooledObject* apObjects[6];
+	for(auto& pObject : apObjects)
+		pObject = new CPooledObject;
+	EXPECT_EQ(pPool->Live(), 6);
+	EXPECT_EQ(pPool->Peak(), 6);
+	EXPECT_EQ(pPool->Capacity(), 8);
+
+	for(auto& pObject : apObjects)
+		delete pObject;
+	EXPECT_EQ(pPool->Live(), 0);
+	EXPECT_EQ(pPool->Peak(), 6);
+}
+
+TEST(AllocPool, ReusesFreedObjects)
+{
+	CPooledObject* pFirst = new CPooledObject;
+	pFirst->m_aData[3] = 42;
+	delete pFirst;
+
+	// the slot comes back zeroed
+	CPooledObject* pSecond = new CPooledObject;
+	EXPECT_EQ(pSecond, pFirst);
+	EXPECT_EQ(pSecond->m_aData[3], 0);
+	delete pSecond;
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <game/server/mmocore/Utils/ClientDataStorage.h>
+
+#include <map>
+
+TEST(ClientDataStorage, MatchesMap)
+{
+	CFlatStableMap<int, int> Flat;
+	std::map<int, int> Map;
+	unsigned Seed = 3;
+	for(int i = 0; i < 2000; i++)
+	{
+		Seed = Seed * 1103515245 + 12345;
+		const int Key = (Seed >> 8) % 300;
+		Flat[Key] += i;
+		Map[Key] += i;
+	}
+
+	ASSERT_EQ(Flat.size(), Map.size());
+	auto It = Map.begin();
+	for(const auto& [Key, Value] : Flat)
+	{
+		EXPECT_EQ(Key, It->first);
+		EXPECT_EQ(Value, It->second);
+		++It;
+	}
+	EXPECT_TRUE(Flat.find(1000) == Flat.end());
+	EXPECT_EQ(Flat.find(Map.begin()->first)->second, Map.begin()->second);
+}
+
+TEST(ClientDataStorage, StableDuringInsert)
+{
+	CFlatStableMap<int, int> Flat;
+	Flat[10] = 1;
+	Flat[30] = 3;
+	int *pValue = &Flat[10];
+
+	// inserting while iterating visits keys behind the current one, as std::map does
+	int Visited = 0;
+	for(auto& [Key, Value] : Flat)
+	{
+		Visited++;
+		if(Key == 10)
+		{
+			Flat[5] = 0;
+			Flat[20] = 2;
+		}
+	}
+	EXPECT_EQ(Visited, 3);
+	EXPECT_EQ(pValue, &Flat[10]);
+	EXPECT_EQ(*pValue, 1);
+
+	CClientFlatStorage<int, int> Storage;
+	Storage[MAX_CLIENTS - 1][7] = 7;
+	Storage.erase(MAX_CLIENTS - 1);
+	EXPECT_TRUE(Storage[MAX_CLIENTS - 1].empty());
+}
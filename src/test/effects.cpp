@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <game/server/mmocore/Utils/Effects.h>
+
+#include <vector>
+
+TEST(Effects, DefaultIDs)
+{
+	CEffectRegistry& Registry = CEffectRegistry::Get();
+	EXPECT_EQ(Registry.Intern("Slowdown"), EFFECT_SLOWDOWN);
+	EXPECT_EQ(Registry.Intern("RegenMana"), EFFECT_REGEN_MANA);
+	EXPECT_STREQ(Registry.Name(EFFECT_POISON), "Poison");
+	EXPECT_EQ(Registry.Intern(""), EFFECT_NONE);
+}
+
+TEST(Effects, Intern)
+{
+	CEffectRegistry& Registry = CEffectRegistry::Get();
+	EXPECT_EQ(Registry.Find("TestEffect"), EFFECT_NONE);
+	const int ID = Registry.Intern("TestEffect");
+	EXPECT_GE(ID, NUM_DEFAULT_EFFECTS);
+	EXPECT_EQ(Registry.Intern("TestEffect"), ID);
+	EXPECT_EQ(Registry.Find("TestEffect"), ID);
+	EXPECT_STREQ(Registry.Name(ID), "TestEffect");
+}
+
+TEST(Effects, Timers)
+{
+	CEffectTimers Timers;
+	EXPECT_TRUE(Timers.Empty());
+	Timers.Set(EFFECT_FIRE, 1);
+	Timers.Set(EFFECT_POISON, 3);
+	EXPECT_TRUE(Timers.IsActive(EFFECT_FIRE));
+	EXPECT_FALSE(Timers.IsActive(EFFECT_SLOWDOWN));
+	EXPECT_FALSE(Timers.IsActive(EFFECT_NONE));
+
+	std::vector<int> aExpired;
+	Timers.Tick([&](int ID) { aExpired.push_back(ID); });
+	ASSERT_EQ(aExpired.size(), 1u);
+	EXPECT_EQ(aExpired[0], EFFECT_FIRE);
+	EXPECT_FALSE(Timers.IsActive(EFFECT_FIRE));
+	EXPECT_EQ(Timers.GetSeconds(EFFECT_POISON), 2);
+
+	Timers.Tick([&](int ID) { aExpired.push_back(ID); });
+	Timers.Tick([&](int ID) { aExpired.push_back(ID); });
+	EXPECT_EQ(aExpired.size(), 2u);
+	EXPECT_TRUE(Timers.Empty());
+
+	Timers.Set(MAX_EFFECTS - 1, 5);
+	EXPECT_TRUE(Timers.IsActive(MAX_EFFECTS - 1));
+	Timers.Clear();
+	EXPECT_TRUE(Timers.Empty());
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <base/system.h>
+#include <engine/shared/huffman.h>
+
+static const unsigned char gs_aPlain[] = {0x00, 0x00, 0x00, 0x01, 0x02, 0x05, 'T', 'e', 'e', 'w', 'o', 'r', 'l', 'd', 's', 0x00, 0x00, 0x00, 0x00};
+static const unsigned char gs_aCompressed[] = {0x47, 0x61, 0xa7, 0x90, 0x13, 0x38, 0x41, 0x71, 0x6b, 0x8b, 0xe0, 0xe4, 0x4a, 0x70, 0x22, 0x9d, 0xbe, 0xe2, 0x06};
+
+TEST(Huffman, WireFormat)
+{
+	static CHuffman s_Huffman;
+	s_Huffman.Init();
+
+	unsigned char aOut[64];
+	ASSERT_EQ(s_Huffman.Compress(gs_aPlain, sizeof(gs_aPlain), aOut, sizeof(aOut)), (int)sizeof(gs_aCompressed));
+	EXPECT_EQ(mem_comp(aOut, gs_aCompressed, sizeof(gs_aCompressed)), 0);
+
+	ASSERT_EQ(s_Huffman.Decompress(gs_aCompressed, sizeof(gs_aCompressed), aOut, sizeof(aOut)), (int)sizeof(gs_aPlain));
+	EXPECT_EQ(mem_comp(aOut, gs_aPlain, sizeof(gs_aPlain)), 0);
+}
+
+TEST(Huffman, RoundTrip)
+{
+	static CHuffman s_Huffman;
+	s_Huffman.Init();
+
+	unsigned char aPlain[1024];
+	unsigned char aCompressed[2048];
+	unsigned char aOut[1024];
+	unsigned Seed = 1;
+	for(int Size = 0; Size <= (int)sizeof(aPlain); Size += 37)
+	{
+		// mostly zeroes like snapshot deltas, with some noise
+		for(int i = 0; i < Size; i++)
+		{
+			Seed = Seed * 1103515245 + 12345;
+			aPlain[i] = (Seed >> 16) % 4 ? 0 : (unsigned char)(Seed >> 8);
+		}
+
+		int CompressedSize = s_Huffman.Compress(aPlain, Size, aCompressed, sizeof(aCompressed));
+		ASSERT_GT(CompressedSize, 0);
+		ASSERT_EQ(s_Huffman.Decompress(aCompressed, CompressedSize, aOut, sizeof(aOut)), Size);
+		EXPECT_EQ(mem_comp(aOut, aPlain, Size), 0);
+	}
+}
+
+TEST(Huffman, Overflow)
+{
+	static CHuffman s_Huffman;
+	s_Huffman.Init();
+
+	unsigned char aOut[64];
+	EXPECT_EQ(s_Huffman.Compress(gs_aPlain, sizeof(gs_aPlain), aOut, sizeof(gs_aCompressed) - 1), -1);
+	EXPECT_EQ(s_Huffman.Decompress(gs_aCompressed, sizeof(gs_aCompressed), aOut, sizeof(gs_aPlain) - 1), -1);
+}
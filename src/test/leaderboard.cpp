@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <game/server/mmocore/Utils/Leaderboard.h>
+
+#include <algorithm>
+
+TEST(Leaderboard, Rank)
+{
+	CLeaderboard Leaderboard;
+	Leaderboard.Set(1, 100);
+	Leaderboard.Set(2, 300);
+	Leaderboard.Set(3, 200);
+	Leaderboard.Set(4, 200);
+
+	EXPECT_EQ(Leaderboard.Num(), 4);
+	EXPECT_EQ(Leaderboard.GetRank(2), 1);
+	EXPECT_EQ(Leaderboard.GetRank(3), 2);
+	EXPECT_EQ(Leaderboard.GetRank(4), 3);
+	EXPECT_EQ(Leaderboard.GetRank(1), 4);
+	EXPECT_EQ(Leaderboard.GetRank(5), -1);
+
+	Leaderboard.Set(1, 400);
+	EXPECT_EQ(Leaderboard.GetRank(1), 1);
+	EXPECT_EQ(Leaderboard.GetRank(2), 2);
+
+	Leaderboard.Remove(2);
+	EXPECT_EQ(Leaderboard.Num(), 3);
+	EXPECT_EQ(Leaderboard.GetRank(2), -1);
+	EXPECT_EQ(Leaderboard.GetRank(3), 2);
+
+	auto aTop = Leaderboard.GetTop(2);
+	ASSERT_EQ(aTop.size(), 2u);
+	EXPECT_EQ(aTop[0].first, 1);
+	EXPECT_EQ(aTop[0].second, 400);
+	EXPECT_EQ(aTop[1].first, 3);
+}
+
+TEST(Leaderboard, MatchesSort)
+{
+	CLeaderboard Leaderboard;
+	int aScores[500] = {};
+	unsigned Seed = 7;
+	for(int Step = 0; Step < 5000; Step++)
+	{
+		Seed = Seed * 1103515245 + 12345;
+		const int ID = (Seed >> 8) % 500;
+		aScores[ID] = (Seed >> 16) % 1000 + 1;
+		Leaderboard.Set(ID, aScores[ID]);
+	}
+
+	std::vector<std::pair<int, int64>> aExpected;
+	for(int i = 0; i < 500; i++)
+	{
+		if(aScores[i])
+			aExpected.emplace_back(i, aScores[i]);
+	}
+	std::sort(aExpected.begin(), aExpected.end(), [](const auto& a, const auto& b) { return a.second > b.second || (a.second == b.second && a.first < b.first); });
+
+	EXPECT_EQ(Leaderboard.GetTop(1000), aExpected);
+	for(int i = 0; i < (int)aExpected.size(); i++)
+		EXPECT_EQ(Leaderboard.GetRank(aExpected[i].first), i + 1);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <teeother/components/localization.h>
+
+static std::string Format(CLocalization& Localization, CLocalization::CLanguage* pLanguage, const char* pText, ...)
+{
+	va_list VarArgs;
+	va_start(VarArgs, pText);
+	dynamic_string Buffer;
+	Localization.Format_V(Buffer, pLanguage, pText, VarArgs);
+	va_end(VarArgs);
+	return Buffer.buffer();
+}
+
+TEST(Localization, Substitution)
+{
+	CLocalization Localization(nullptr);
+	CLocalization::CLanguage Language("English", "en", "");
+
+	EXPECT_EQ(Format(Localization, &Language, "Hello {STR}!", "world"), "Hello world!");
+	EXPECT_EQ(Format(Localization, &Language, "{INT} and {INT}", 12345, -7), "12345 and -7");
+	EXPECT_EQ(Format(Localization, &Language, "Gold: {VAL}", 1234567), "Gold: 1,234,567");
+	EXPECT_EQ(Format(Localization, &Language, "{STR}x{VAL} left", "Potion", 999), "Potionx999 left");
+}
+
+TEST(Localization, PlainTextSkipsCache)
+{
+	CLocalization Localization(nullptr);
+	CLocalization::CLanguage Language("English", "en", "");
+
+	EXPECT_EQ(Format(Localization, &Language, "Nothing to replace"), "Nothing to replace");
+	EXPECT_EQ(Language.NumCachedFormats(), 0);
+}
+
+TEST(Localization, CacheHit)
+{
+	CLocalization Localization(nullptr);
+	CLocalization::CLanguage Language("English", "en", "");
+
+	// a buffer reused with another text must not get the old template
+	char aText[64];
+	str_copy(aText, "{STR} has {INT}", sizeof(aText));
+	const std::string First = Format(Localization, &Language, aText, "Tee", 5);
+	EXPECT_EQ(Format(Localization, &Language, aText, "Tee", 5), First);
+	EXPECT_EQ(Language.NumCachedFormats(), 1);
+
+	str_copy(aText, "{INT} for {STR}", sizeof(aText));
+	EXPECT_EQ(Format(Localization, &Language, aText, 5, "Tee"), "5 for Tee");
+	EXPECT_EQ(Language.NumCachedFormats(), 2);
+}
+
+TEST(Localization, CacheFull)
+{
+	CLocalization Localization(nullptr);
+	CLocalization::CLanguage Language("English", "en", "");
+
+	const char* pHot = "Hot {INT}";
+	EXPECT_EQ(Format(Localization, &Language, pHot, 1), "Hot 1");
+
+	char aText[64];
+	for(int i = 0; i < CLocalization::MAX_FORMAT_CACHE * 2; i++)
+	{
+		// the hot template keeps being used while the cache fills up with one-off texts
+		str_format(aText, sizeof(aText), "Text %d {INT}", i);
+		EXPECT_EQ(Format(Localization, &Language, aText, i), std::string(aText, str_length(aText) - 5) + std::to_string(i));
+		EXPECT_EQ(Format(Localization, &Language, pHot, i), "Hot " + std::to_string(i));
+	}
+	EXPECT_EQ(Language.NumCachedFormats(), (int)CLocalization::MAX_FORMAT_CACHE);
+}
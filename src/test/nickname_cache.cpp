@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <game/server/mmocore/Utils/NicknameCache.h>
+
+TEST(NicknameCache, GetSet)
+{
+	CNicknameCache Cache(4);
+	char aName[32];
+	EXPECT_FALSE(Cache.Get(1, aName, sizeof(aName)));
+
+	Cache.Set(1, "first");
+	ASSERT_TRUE(Cache.Get(1, aName, sizeof(aName)));
+	EXPECT_STREQ(aName, "first");
+
+	Cache.Set(1, "renamed");
+	ASSERT_TRUE(Cache.Get(1, aName, sizeof(aName)));
+	EXPECT_STREQ(aName, "renamed");
+	EXPECT_EQ(Cache.Num(), 1);
+}
+
+TEST(NicknameCache, EvictsLeastRecentlyUsed)
+{
+	CNicknameCache Cache(3);
+	char aName[32];
+	Cache.Set(1, "a");
+	Cache.Set(2, "b");
+	Cache.Set(3, "c");
+	EXPECT_TRUE(Cache.Get(1, aName, sizeof(aName)));
+
+	Cache.Set(4, "d");
+	EXPECT_EQ(Cache.Num(), 3);
+	EXPECT_TRUE(Cache.Get(1, aName, sizeof(aName)));
+	EXPECT_FALSE(Cache.Get(2, aName, sizeof(aName)));
+	EXPECT_TRUE(Cache.Get(4, aName, sizeof(aName)));
+}
+
+TEST(NicknameCache, OnlineArePinned)
+{
+	CNicknameCache Cache(2);
+	char aName[32];
+	Cache.SetOnline(1, "online");
+	Cache.Set(2, "b");
+	Cache.Set(3, "c");
+	Cache.Set(4, "d");
+	EXPECT_TRUE(Cache.Get(1, aName, sizeof(aName)));
+	EXPECT_FALSE(Cache.Get(3, aName, sizeof(aName)));
+	EXPECT_TRUE(Cache.Get(4, aName, sizeof(aName)));
+
+	Cache.SetOffline(1);
+	Cache.Set(5, "e");
+	EXPECT_FALSE(Cache.Get(1, aName, sizeof(aName)));
+}
+
+TEST(NicknameCache, Missing)
+{
+	CNicknameCache Cache;
+	Cache.Set(2, "b");
+
+	std::vector<int> aMissing;
+	Cache.GetMissing({ 1, 2, 3, 1, 0 }, aMissing);
+	ASSERT_EQ(aMissing.size(), 2u);
+	EXPECT_EQ(aMissing[0], 1);
+	EXPECT_EQ(aMissing[1], 3);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <engine/shared/profiler.h>
+
+TEST(Profiler, RegisterSection)
+{
+	static CTickProfiler s_Profiler;
+	int Tick = s_Profiler.RegisterSection("tick");
+	EXPECT_EQ(s_Profiler.RegisterSection("tick"), Tick);
+	EXPECT_NE(s_Profiler.RegisterSection("network"), Tick);
+	EXPECT_STREQ(s_Profiler.SectionName(Tick), "tick");
+}
+
+TEST(Profiler, Percentiles)
+{
+	static CTickProfiler s_Profiler;
+	int Section = s_Profiler.RegisterSection("section");
+	int Idle = s_Profiler.RegisterSection("idle");
+	const int64 Freq = time_freq();
+	for(int i = 1; i <= 100; i++)
+	{
+		s_Profiler.Add(Section, Freq * i / 1000000);
+		s_Profiler.OnTickEnd();
+	}
+
+	CTickProfiler::CStats Stats;
+	s_Profiler.GetStats(Section, &Stats);
+	EXPECT_EQ(Stats.m_NumSamples, 100);
+	EXPECT_LE(Stats.m_P50Us, Stats.m_P95Us);
+	EXPECT_LE(Stats.m_P95Us, Stats.m_P99Us);
+	EXPECT_LE(Stats.m_P99Us, Stats.m_MaxUs);
+	EXPECT_NEAR(Stats.m_MaxUs, 100, 1);
+
+	s_Profiler.GetStats(Idle, &Stats);
+	EXPECT_EQ(Stats.m_NumSamples, 0);
+
+	s_Profiler.SetEnabled(false);
+	s_Profiler.GetStats(Section, &Stats);
+	EXPECT_EQ(Stats.m_NumSamples, 0);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <teeother/tl/string_hashtable.h>
+
+TEST(StringHashtable, Empty)
+{
+	string_hashtable Table;
+	EXPECT_EQ(Table.size(), 0);
+	EXPECT_EQ(Table.get("key"), nullptr);
+}
+
+TEST(StringHashtable, SetGet)
+{
+	string_hashtable Table;
+	Table.set("Hello", "Привет");
+	Table.set("World", "Мир");
+	EXPECT_STREQ(Table.get("Hello"), "Привет");
+	EXPECT_STREQ(Table.get("World"), "Мир");
+	EXPECT_EQ(Table.get("hello"), nullptr);
+
+	Table.set("Hello", "Здравствуй");
+	EXPECT_EQ(Table.size(), 2);
+	EXPECT_STREQ(Table.get("Hello"), "Здравствуй");
+
+	Table.clear();
+	EXPECT_EQ(Table.get("Hello"), nullptr);
+}
+
+TEST(StringHashtable, Grow)
+{
+	string_hashtable Table;
+	char aKey[32];
+	char aValue[32];
+	for(int i = 0; i < 5000; i++)
+	{
+		str_format(aKey, sizeof(aKey), "key %d", i);
+		str_format(aValue, sizeof(aValue), "value %d", i);
+		Table.set(aKey, aValue);
+	}
+
+	EXPECT_EQ(Table.size(), 5000);
+	for(int i = 0; i < 5000; i++)
+	{
+		str_format(aKey, sizeof(aKey), "key %d", i);
+		str_format(aValue, sizeof(aValue), "value %d", i);
+		ASSERT_STREQ(Table.get(aKey), aValue);
+	}
+	EXPECT_EQ(Table.get("key 5000"), nullptr);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <game/server/mmocore/Utils/WorldRouting.h>
+
+TEST(WorldRouting, ShortestRoute)
+{
+	// 0 - 1 - 2 - 3 and a shortcut 0 - 3
+	CWorldRoutingTable Routing;
+	Routing.AddSwap(0, 1, vec2(10, 0));
+	Routing.AddSwap(1, 0, vec2(11, 0));
+	Routing.AddSwap(1, 2, vec2(12, 0));
+	Routing.AddSwap(2, 1, vec2(21, 0));
+	Routing.AddSwap(2, 3, vec2(23, 0));
+	Routing.AddSwap(3, 2, vec2(32, 0));
+	Routing.AddSwap(0, 3, vec2(3, 0));
+	Routing.AddSwap(3, 0, vec2(30, 0));
+
+	vec2 Pos;
+	ASSERT_TRUE(Routing.GetNextSwap(0, 3, &Pos));
+	EXPECT_EQ(Pos.x, 3);
+	EXPECT_EQ(Routing.GetDistance(0, 3), 1);
+
+	ASSERT_TRUE(Routing.GetNextSwap(0, 2, &Pos));
+	EXPECT_EQ(Pos.x, 10);
+	EXPECT_EQ(Routing.GetDistance(0, 2), 2);
+
+	// equal routes, the swapper added first is taken
+	EXPECT_EQ(Routing.GetNextWorld(1, 3), 0);
+	EXPECT_EQ(Routing.GetNextWorld(3, 1), 2);
+	EXPECT_EQ(Routing.GetDistance(1, 3), 2);
+	EXPECT_EQ(Routing.GetDistance(2, 2), 0);
+}
+
+TEST(WorldRouting, Unreachable)
+{
+	CWorldRoutingTable Routing;
+	Routing.AddSwap(0, 1, vec2(1, 0));
+	Routing.AddSwap(2, 3, vec2(2, 0));
+
+	vec2 Pos(-1, -1);
+	EXPECT_FALSE(Routing.GetNextSwap(0, 3, &Pos));
+	EXPECT_EQ(Pos.x, -1);
+	EXPECT_FALSE(Routing.GetNextSwap(1, 0, &Pos));
+	EXPECT_FALSE(Routing.GetNextSwap(0, 7, &Pos));
+	EXPECT_EQ(Routing.GetDistance(0, 3), -1);
+	EXPECT_EQ(Routing.GetNextWorld(0, 1), 1);
+}
+
+TEST(WorldRouting, RebuildAfterAdd)
+{
+	CWorldRoutingTable Routing;
+	EXPECT_TRUE(Routing.AddSwap(0, 1, vec2(1, 0)));
+	EXPECT_FALSE(Routing.AddSwap(0, 1, vec2(1, 0)));
+	EXPECT_EQ(Routing.GetNextWorld(0, 2), -1);
+
+	// worlds are loaded one by one, the next lookup sees the new swapper
+	Routing.AddSwap(1, 2, vec2(2, 0));
+	EXPECT_EQ(Routing.GetNextWorld(0, 2), 1);
+	EXPECT_EQ(Routing.GetDistance(0, 2), 2);
+
+	Routing.Clear();
+	EXPECT_EQ(Routing.GetNextWorld(0, 1), -1);
+}